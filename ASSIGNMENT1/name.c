@@ -2,24 +2,114 @@
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
+#include <time.h> // clock_gettime
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <pthread.h> // pthread_create (컴파일 시 -pthread)
 
-#define MAX_YEAR_DURATION	10	// 기간
+#define MAX_YEAR_DURATION	140	// 최대 기간 (freq 행렬의 열은 필요한 만큼만 할당)
 #define LINEAR_SEARCH 0
 #define BINARY_SEARCH 1
+#define HASH_SEARCH 2
+#define K_WAY_MERGE 3
+#define MMAP_SEARCH 4
+#define PARALLEL_MERGE 5
+
+// 이름 문자열 풀 (interned string arena)
+// 모든 이름을 널 종료 문자열로 이어 붙여 저장하고, 같은 이름은 한 번만 저장
+typedef struct {
+	int		len;			// 풀에 저장된 바이트 수
+	int		capacity;		// 풀의 용량 (바이트)
+	char	*data;			// 문자열 풀의 포인터
+	int		num_keys;		// 풀에 저장된 문자열의 수
+	int		slot_capacity;	// 해시 슬롯의 수 (2의 거듭제곱)
+	unsigned int *slot;		// 문자열의 위치 + 1, 빈 슬롯은 0
+} tPool;
 
 // 구조체 선언
+// 이름 문자열은 풀에, 연도별 빈도는 열 우선(column-major) 행렬에 따로 저장
 typedef struct {
-	char	name[20];		// 이름
-	char	sex;			// 성별 'M' or 'F'
-	int		freq[MAX_YEAR_DURATION]; // 연도별 빈도
+	unsigned int	offset;	// 풀에서 이름의 위치
+	unsigned short	len;	// 이름의 길이
+	char			sex;	// 성별 'M' or 'F'
+	int				row;	// freq 행렬에서의 행 번호
 } tName;
 
 typedef struct {
 	int		len;		// 배열에 저장된 이름의 수
-	int		capacity;	// 배열의 용량 (배열에 저장 가능한 이름의 수)
+	int		capacity;	// 배열의 용량 (배열에 저장 가능한 이름의 수, freq 행렬의 행 수)
 	tName	*data;		// 이름 배열의 포인터
+	tPool	pool;		// 이름 문자열 풀
+	int		num_year;	// freq 행렬의 열 수
+	int		*freq;		// 연도별 빈도 행렬, freq[year_index * capacity + row]
 } tNames;
 
+// (이름, 성별) -> 이름 배열 인덱스 해시 인덱스 (open addressing, linear probing)
+// 키는 tNames->data에 저장되어 있으므로 슬롯에는 배열 인덱스만 저장
+typedef struct {
+	int		len;		// 인덱스에 저장된 키의 수
+	int		capacity;	// 슬롯의 수 (2의 거듭제곱)
+	int		*slot;		// 이름 배열의 인덱스, 빈 슬롯은 -1
+} tIndex;
+
+// mmap된 파일의 한 줄을 가리키는 뷰 (name은 널 종료가 아님)
+typedef struct {
+	const char	*name;		// 이름의 시작 위치
+	int			name_len;	// 이름의 길이
+	char		sex;		// 성별 'M' or 'F'
+	int			freq;		// 빈도
+} tView;
+
+// 연도별 파일 하나를 (이름, 성별) 순으로 정렬한 배열 (k-way merge의 입력)
+// 각 항목은 mmap된 파일을 복사 없이 가리킴
+typedef struct {
+	int		len;		// 배열에 저장된 항목의 수
+	int		capacity;	// 배열의 용량
+	int		year_index;	// 연도 인덱스 (freq 행렬의 열)
+	tView	*data;		// 항목 배열의 포인터
+	char	*base;		// mmap된 파일의 시작 위치
+	size_t	size;		// mmap된 파일의 크기
+} tRun;
+
+// 병렬 로딩 작업 정보 (작업자 스레드들이 공유)
+typedef struct {
+	char	**files;		// 입력 파일 이름 배열
+	int		num_files;		// 입력 파일의 수
+	int		start_year;		// 첫 연도
+	int		next;			// 다음에 처리할 파일 번호
+	int		error;			// 열지 못한 파일이 있으면 1
+	tRun	*runs;			// 파일별 결과 (runs[i]는 files[i]의 run)
+	pthread_mutex_t	lock;	// next, error 보호
+} tJob;
+
+// 스냅샷 파일 헤더
+// 헤더 뒤에는 이름 위치 열(unsigned int x num_names), 성별 열(char x num_names),
+// 문자열 블록(pool_len 바이트), freq 행렬(int x num_year x num_names, 열 우선)이
+// 차례로 저장되며 각 구역은 4바이트 단위로 정렬됨
+// 행은 이름순 (이름이 같은 경우 성별순)으로 정렬되어 있음
+#define SNAPSHOT_MAGIC		"NAMESNAP"
+#define SNAPSHOT_VERSION	1
+
+typedef struct {
+	char			magic[8];	// SNAPSHOT_MAGIC
+	unsigned int	version;	// SNAPSHOT_VERSION
+	unsigned int	num_names;	// 이름의 수 (행의 수)
+	unsigned int	num_year;	// 연도의 수 (열의 수)
+	unsigned int	pool_len;	// 문자열 블록의 크기 (바이트)
+} tSnapHeader;
+
+// mmap된 스냅샷 파일 (모든 포인터는 mapping 안을 가리킴)
+typedef struct {
+	void				*base;		// mapping의 시작 위치
+	size_t				size;		// mapping의 크기
+	int					num_names;	// 이름의 수
+	int					num_year;	// 연도의 수
+	const unsigned int	*offset;	// 이름 위치 열 (문자열 블록 안의 위치)
+	const char			*sex;		// 성별 열
+	const char			*pool;		// 문자열 블록
+	const int			*freq;		// freq 행렬, freq[year_index * num_names + row]
+} tSnapshot;
+
 ////////////////////////////////////////////////////////////////////////////////
 // 함수 원형 선언(declaration)
 
@@ -34,6 +124,55 @@ void load_names_lsearch( FILE *fp, int year_index, tNames *names);
 // 이진탐색(binary search) 버전 (bsearch 함수 이용)
 void load_names_bsearch( FILE *fp, int year_index, tNames *names);
 
+// 해시탐색(hash search) 버전
+// 이름 배열은 정렬하지 않고 뒤에 추가만 하므로 qsort는 모든 파일을 읽은 후 한 번만 수행
+void load_names_hsearch( FILE *fp, int year_index, tNames *names, tIndex *index);
+
+// mmap 버전 (해시탐색)
+// 파일을 mmap하고 직접 작성한 스캐너로 줄을 잘라 fgets, sscanf 없이 복사 없이 처리
+void load_names_mmap( FILE *fp, int year_index, tNames *names, tIndex *index);
+
+// k-way merge 버전 (1단계)
+// 연도별 입력 파일 하나를 mmap하여 run에 저장한 후 (이름, 성별) 순으로 한 번 정렬
+void load_run( FILE *fp, int year_index, tRun *run);
+
+// run에 할당된 메모리와 mapping을 해제
+void destroy_run( tRun *run);
+
+// k-way merge 버전 (2단계)
+// 정렬된 run들을 힙으로 한 번에 병합하여 정렬된 이름 배열을 만듦
+// 같은 키는 연속해서 나오므로 freq[year_index]만 채우면 되고 validate가 필요 없음
+void merge_runs( tRun *runs, int num_runs, tNames *names);
+
+// 병렬 k-way merge 버전 (1단계)
+// num_threads개의 작업자 스레드가 파일을 하나씩 가져가 각자의 run에 load_run 수행
+// 2단계는 merge_runs로 한 번에 병합
+// return	1 성공
+//			0 열지 못한 파일이 있음
+int load_runs_parallel( char **files, int num_files, int start_year, int num_threads, tRun *runs);
+
+// 정렬된 이름 구조체를 스냅샷 파일로 저장 (num_year개의 연도만 저장)
+// return	1 성공
+//			0 실패
+int save_snapshot( const char *path, tNames *names, int num_year);
+
+// 스냅샷 파일을 mmap하여 읽기 전용으로 엶 (다시 만들지 않고 mapping을 그대로 사용)
+// return	스냅샷 포인터
+//			NULL 파일이 없거나 형식/버전이 맞지 않음
+tSnapshot *load_snapshot( const char *path);
+
+// 스냅샷의 mapping을 해제
+void destroy_snapshot( tSnapshot *snap);
+
+// 스냅샷에서 (이름, 성별)을 이진탐색
+// return	행 번호
+//			-1 없음
+int find_snapshot( tSnapshot *snap, const char *name, char sex);
+
+// 스냅샷의 한 행 / 전체를 print_names와 같은 형식으로 출력
+void print_snapshot_row( tSnapshot *snap, int row);
+void print_snapshot( tSnapshot *snap);
+
 // 구조체 배열을 화면에 출력
 void print_names( tNames *names, int num_year);
 
@@ -41,9 +180,35 @@ void print_names( tNames *names, int num_year);
 // 정렬 기준 : 이름(1순위), 성별(2순위)
 int compare( const void *n1, const void *n2);
 
+// tView를 위한 비교 함수 (정렬 기준은 compare와 같음)
+int compare_view( const void *n1, const void *n2);
+
 void validate(tNames *names);
 
-int isSame(char *curName, char curSex, tName *name);
+int isSame(unsigned int curOffset, char curSex, tName *name);
+
+// 이름 문자열을 풀에 저장하고 풀에서의 위치를 반환
+// 이미 저장된 문자열이면 기존 위치를 반환 (str은 널 종료가 아니어도 됨)
+unsigned int pool_intern( tPool *pool, const char *str, int len);
+
+// 이름 배열 끝에 빈도가 모두 0인 이름을 추가하고 그 주소를 반환
+tName *add_name( tNames *names, unsigned int offset, int len, char sex);
+
+// 연도별 빈도를 저장/반환
+void set_freq( tNames *names, tName *name, int year_index, int freq);
+int get_freq( tNames *names, tName *name, int year_index);
+
+// 이름 배열과 freq 행렬의 용량을 두배로 늘림
+void grow_names( tNames *names);
+
+// 이름 배열을 정렬 (이름순 (이름이 같은 경우 성별순))
+void sort_names( tNames *names);
+
+// 이름 문자열의 주소
+#define NAME_STR(names, p)	((names)->pool.data + (p)->offset)
+
+// compare 함수에서 이름 문자열을 찾을 풀 (qsort, bsearch 호출 전에 설정)
+static const char *g_pool;
 
 ////////////////////////////////////////////////////////////////////////////////
 // 함수 정의 (definition)
@@ -58,6 +223,16 @@ tNames *create_names(void)
 	pnames->len = 0;
 	pnames->capacity = 1;
 	pnames->data = (tName *)malloc(pnames->capacity * sizeof(tName));
+	
+	pnames->num_year = 0;
+	pnames->freq = NULL;
+	
+	pnames->pool.len = 0;
+	pnames->pool.capacity = 1024;
+	pnames->pool.data = (char *)malloc(pnames->pool.capacity);
+	pnames->pool.num_keys = 0;
+	pnames->pool.slot_capacity = 1024;
+	pnames->pool.slot = (unsigned int *)calloc(pnames->pool.slot_capacity, sizeof(unsigned int));
 
 	return pnames;
 }
@@ -66,12 +241,48 @@ tNames *create_names(void)
 void destroy_names(tNames *pnames)
 {
 	free(pnames->data);
+	free(pnames->freq);
+	free(pnames->pool.data);
+	free(pnames->pool.slot);
 	pnames->len = 0;
 	pnames->capacity = 0;
 
 	free(pnames);
 }
 
+// 해시 인덱스를 초기화
+// 모든 슬롯을 -1(빈 슬롯)로 초기화
+// return : 인덱스 포인터
+tIndex *create_index(void)
+{
+	tIndex *pindex = (tIndex *)malloc( sizeof(tIndex));
+	
+	pindex->len = 0;
+	pindex->capacity = 1024;
+	pindex->slot = (int *)malloc(pindex->capacity * sizeof(int));
+	memset(pindex->slot, -1, pindex->capacity * sizeof(int));
+
+	return pindex;
+}
+
+// 해시 인덱스에 할당된 메모리를 해제
+void destroy_index(tIndex *pindex)
+{
+	free(pindex->slot);
+	pindex->len = 0;
+	pindex->capacity = 0;
+
+	free(pindex);
+}
+
+// 현재 시각 (초 단위, 파일별 로딩 시간 측정용)
+double get_time(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
@@ -80,28 +291,111 @@ int main(int argc, char **argv)
 	
 	FILE *fp;
 	int num_year = 0;
+	int first = 2;		// 첫 입력 파일의 argv 위치
+	int num_threads = 1;
+	
+	// 스냅샷 모드: 텍스트 파일을 읽지 않고 스냅샷 파일을 mmap하여 바로 출력
+	// 이름/성별(ex. "Zoe/F")이 주어지면 해당 이름만 찾아서 출력
+	if (argc >= 3 && strcmp( argv[1], "--load") == 0)
+	{
+		tSnapshot *snap = load_snapshot( argv[2]);
+		if (!snap)
+		{
+			fprintf( stderr, "cannot load snapshot : %s\n", argv[2]);
+			return 1;
+		}
+		
+		if (argc == 3) print_snapshot( snap);
+		
+		for (int i = 3; i < argc; i++)
+		{
+			char key[100];
+			strncpy( key, argv[i], sizeof(key)-1);
+			key[sizeof(key)-1] = '\0';
+			
+			char *p = strchr( key, '/');
+			int row = -1;
+			if (p)
+			{
+				*p = '\0';
+				row = find_snapshot( snap, key, p[1]);
+			}
+			
+			if (row != -1) print_snapshot_row( snap, row);
+			else fprintf( stdout, "%s not found\n", argv[i]);
+		}
+		
+		destroy_snapshot( snap);
+		return 0;
+	}
 	
+	// --save SNAPSHOT이 주어지면 결과를 스냅샷 파일로도 저장
+	char *save_file = NULL;
+	if (argc > 3 && strcmp( argv[1], "--save") == 0)
+	{
+		save_file = argv[2];
+		argv[2] = argv[0];
+		argv += 2;
+		argc -= 2;
+	}
+
 	if (argc <= 2)
 	{
-		fprintf( stderr, "Usage: %s option FILE...\n\n", argv[0]);
-		fprintf( stderr, "option\n\t-l\n\t\twith linear search\n\t-b\n\t\twith binary search\n");
+		fprintf( stderr, "Usage: %s [--save SNAPSHOT] option FILE...\n", argv[0]);
+		fprintf( stderr, "       %s --load SNAPSHOT [NAME/SEX...]\n\n", argv[0]);
+		fprintf( stderr, "option\n\t-l\n\t\twith linear search\n\t-b\n\t\twith binary search\n\t-h\n\t\twith hash search\n\t-m\n\t\twith k-way merge\n\t-z\n\t\twith hash search (mmap parser)\n\t-j N\n\t\twith k-way merge (N threads)\n");
 		return 1;
 	}
 	
 	if (strcmp( argv[1], "-l") == 0) option = LINEAR_SEARCH;
 	else if (strcmp( argv[1], "-b") == 0) option = BINARY_SEARCH;
+	else if (strcmp( argv[1], "-h") == 0) option = HASH_SEARCH;
+	else if (strcmp( argv[1], "-m") == 0) option = K_WAY_MERGE;
+	else if (strcmp( argv[1], "-z") == 0) option = MMAP_SEARCH;
+	else if (strcmp( argv[1], "-j") == 0) option = PARALLEL_MERGE;
 	else {
 		fprintf( stderr, "unknown option : %s\n", argv[1]);
 		return 1;
 	}
 	
+	if (option == PARALLEL_MERGE)
+	{
+		num_threads = atoi( argv[2]);
+		first = 3;
+		if (num_threads <= 0 || argc <= first)
+		{
+			fprintf( stderr, "Usage: %s -j N FILE...\n", argv[0]);
+			return 1;
+		}
+	}
+	
 	// 이름 구조체 초기화
 	names = create_names();
+	
+	// 해시 인덱스 초기화 (해시탐색, mmap 모드에서만 사용)
+	tIndex *index = NULL;
+	if (option == HASH_SEARCH || option == MMAP_SEARCH) index = create_index();
+	
+	// 연도별 정렬 배열 (k-way merge 모드에서만 사용)
+	tRun *runs = NULL;
+	if (option == K_WAY_MERGE || option == PARALLEL_MERGE) runs = (tRun *)calloc( argc-first, sizeof(tRun));
 
 	// 첫 연도 알아내기 "yob2009.txt" -> 2009
-	int start_year = atoi( &argv[2][strlen(argv[2])-8]);
+	int start_year = atoi( &argv[first][strlen(argv[first])-8]);
 	
-	for (int i = 2; i < argc; i++)
+	if (option == PARALLEL_MERGE)
+	{
+		// 병렬 모드 (연도별 로딩, 정렬은 작업자 스레드가 수행)
+		fprintf( stderr, "Processing %d files with %d threads..\n", argc-first, num_threads);
+		double start_time = get_time();
+		
+		if (!load_runs_parallel( &argv[first], argc-first, start_year, num_threads, runs)) return 1;
+		num_year = argc-first;
+		
+		fprintf( stderr, "Loaded in %.3f sec\n", get_time() - start_time);
+	}
+	
+	for (int i = first; i < argc && option != PARALLEL_MERGE; i++)
 	{
 		num_year++;
 		fp = fopen( argv[i], "r");
@@ -112,7 +406,12 @@ int main(int argc, char **argv)
 
 		int year = atoi( &argv[i][strlen(argv[i])-8]); // ex) "yob2009.txt" -> 2009
 		
-		fprintf( stderr, "Processing [%s]..\n", argv[i]);
+		fprintf( stderr, "Processing [%s]..", argv[i]);
+		double start_time = get_time();
+		
+		// 처리량(MB/s) 계산을 위한 파일 크기
+		struct stat st;
+		fstat( fileno(fp), &st);
 		
 		if (option == LINEAR_SEARCH)
 		{
@@ -121,22 +420,63 @@ int main(int argc, char **argv)
 			load_names_lsearch( fp, year-start_year, names);
 		
 		}
+		else if (option == HASH_SEARCH)
+		{
+			// 해시탐색 모드 (정렬은 마지막에 한 번만)
+			load_names_hsearch( fp, year-start_year, names, index);
+		}
+		else if (option == MMAP_SEARCH)
+		{
+			// mmap 모드 (해시탐색과 같고 파서만 다름)
+			load_names_mmap( fp, year-start_year, names, index);
+		}
+		else if (option == K_WAY_MERGE)
+		{
+			// k-way merge 모드 (연도별로 따로 정렬만 하고 병합은 마지막에 한 번)
+			load_run( fp, year-start_year, &runs[num_year-1]);
+		}
 		else // (option == BINARY_SEARCH)
 		{
 			// 이진탐색 모드
 			load_names_bsearch( fp, year-start_year, names);
 			
 			// 정렬 (이름순 (이름이 같은 경우 성별순))
-			qsort( names->data, names->len, sizeof(tName), compare);
+			sort_names( names);
 		}
 		fclose( fp);
-
+		
+		double elapsed = get_time() - start_time;
+		fprintf( stderr, " %.3f sec (%.1f MB/s)\n", elapsed, st.st_size / elapsed / 1e6);
 	}
 	
-	// 정렬 (이름순 (이름이 같은 경우 성별순))
-	qsort( names->data, names->len, sizeof(tName), compare);
+	if (index) destroy_index( index);
+	
+	if (option == K_WAY_MERGE || option == PARALLEL_MERGE)
+	{
+		fprintf( stderr, "Merging %d runs..", num_year);
+		double start_time = get_time();
+		
+		// 병합 결과는 이미 정렬되어 있고 중복이 없음
+		merge_runs( runs, num_year, names);
+		
+		fprintf( stderr, " %.3f sec\n", get_time() - start_time);
+		
+		for (int i = 0; i < num_year; i++) destroy_run( &runs[i]);
+		free( runs);
+	}
+	else
+	{
+		// 정렬 (이름순 (이름이 같은 경우 성별순))
+		sort_names( names);
+		
+		validate(names);
+	}
 	
-	validate(names);
+	// 스냅샷 파일로 저장
+	if (save_file && !save_snapshot( save_file, names, num_year))
+	{
+		fprintf( stderr, "cannot save snapshot : %s\n", save_file);
+	}
 	
 	// 이름 구조체를 화면에 출력
 	print_names( names, num_year);
@@ -147,14 +487,13 @@ int main(int argc, char **argv)
 	return 0;
 }
 
-int lsearch(tNames *names, char* name, char sex){
+int lsearch(tNames *names, unsigned int offset, char sex){
 
+	// 같은 이름은 풀에 한 번만 저장되므로 위치만 비교하면 됨
 	for(int i=0;i<names->len;i++){
-		tName temp = (names->data)[i];
-		if(!strcmp(temp.name, name)){ 
-			if(temp.sex == sex){
-				return i;
-			}
+		tName *temp = names->data + i;
+		if(temp->offset == offset && temp->sex == sex){
+			return i;
 		}
 	}
 	return -1;
@@ -174,29 +513,21 @@ void load_names_lsearch( FILE *fp, int year_index, tNames *names){
 			ptr = strchr(ptr + 1, ',');
 		}
 
-		char curName[20] = "";
+		char curName[100] = "";
 		char curSex = 0;
 		int curFreq=0;
 		
 		sscanf(fLine,"%s\t%c\t%d", curName, &curSex, &curFreq);
-
-		int index = lsearch(names, curName, curSex);	
+		
+		int len = strlen(curName);
+		unsigned int offset = pool_intern(&names->pool, curName, len);
+		int index = lsearch(names, offset, curSex);	
 
 		if(index == -1){						
-			if(names->capacity == names->len){
-				names->data = realloc(names->data, 2 * names->capacity * sizeof(tName));
-				names->capacity *= 2;
-			}
-
-			strcpy(names->data[names->len].name,curName);
-			names->data[names->len].sex = curSex;
-			memset(names->data[names->len].freq,0,MAX_YEAR_DURATION);
-			names->data[names->len].freq[year_index] = curFreq;
-			names->len++;
-			
+			set_freq(names, add_name(names, offset, len, curSex), year_index, curFreq);
 		}
 		else{
-			names->data[index].freq[year_index] = curFreq;
+			set_freq(names, names->data + index, year_index, curFreq);
 		}							
 	}
 	free(fLine);
@@ -219,45 +550,500 @@ void load_names_bsearch( FILE *fp, int year_index, tNames *names){
 			ptr = strchr(ptr + 1, ',');
 		}
 		
+		char curName[100] = "";
 		tName tempData;
-		memset(tempData.freq, 0, MAX_YEAR_DURATION);
 		//임시 데이터에 저장
-		sscanf(fLine,"%s %c %d", tempData.name, &(tempData.sex), &curFreq);
+		sscanf(fLine,"%s %c %d", curName, &(tempData.sex), &curFreq);
+		
+		//이름을 먼저 풀에 저장해 두면 tempData를 bsearch의 키로 쓸 수 있음
+		tempData.len = strlen(curName);
+		tempData.offset = pool_intern(&names->pool, curName, tempData.len);
+		g_pool = names->pool.data;
+		
+		tName *curAdd = (tName *)bsearch(&tempData, names->data, names->len, sizeof(tName), compare);
 		
-		//배열에 이미 키가 존재할 때
-		if(bsearch(&tempData, names->data, names->len, sizeof(tName), compare) != NULL){
-			tName *curAdd = (tName *)bsearch(&tempData, names->data, names->len, sizeof(tName), compare);
-			curAdd->freq[year_index] = curFreq;
-		}
 		//배열에 키가 존재하지 않을때
-		else{
-			//len과 capacity가 같으면 capacity를 두배로 하고 data 배열을 재할당
-			if(names->len == names->capacity){
-				names->data = (tName *)realloc(names->data,names->capacity * 2 * sizeof(tName));
-				names->capacity *= 2;
-			}
-			
-			tName *curAdd = (tName *)(names->data) + (names->len);
-			strcpy(curAdd->name, tempData.name);
-			curAdd->sex = tempData.sex;
-			memset(curAdd->freq,0,MAX_YEAR_DURATION);
-			curAdd->freq[year_index] = curFreq;
-			names->len++;
+		if(curAdd == NULL){
+			curAdd = add_name(names, tempData.offset, tempData.len, tempData.sex);
 		}
+		set_freq(names, curAdd, year_index, curFreq);
 	}
 	free(fLine);
 }
 
 
+// 문자열 해시 함수 (FNV-1a)
+// str은 널 종료가 아니어도 되도록 길이를 함께 받음
+unsigned int hash_str(const char *str, int len){
+	unsigned int h = 2166136261u;
+	for(int i=0; i<len; i++){
+		h = (h ^ (unsigned char)str[i]) * 16777619u;
+	}
+	return h;
+}
+
+// (이름, 성별) 해시 함수
+// 같은 이름은 풀에서 위치가 같으므로 (위치, 성별)만 섞으면 됨
+unsigned int hash_key(unsigned int offset, char sex){
+	unsigned int h = offset * 2 + (sex == 'M');
+	h = (h ^ (h >> 16)) * 0x45d9f3bu;
+	h = (h ^ (h >> 16)) * 0x45d9f3bu;
+	return h ^ (h >> 16);
+}
+
+// 해시 인덱스의 슬롯 수를 두배로 늘리고, 이름 배열의 키로 다시 채움
+void grow_index(tIndex *index, tNames *names){
+	free(index->slot);
+	index->capacity *= 2;
+	index->slot = (int *)malloc(index->capacity * sizeof(int));
+	memset(index->slot, -1, index->capacity * sizeof(int));
+	
+	unsigned int mask = index->capacity - 1;
+	for(int i=0; i<names->len; i++){
+		tName *cur = names->data + i;
+		unsigned int h = hash_key(cur->offset, cur->sex) & mask;
+		while(index->slot[h] != -1) h = (h + 1) & mask;
+		index->slot[h] = i;
+	}
+}
+
+// 해시 인덱스에서 (이름, 성별)을 찾아 이름 구조체의 주소를 반환
+// 없으면 배열 끝에 빈도가 0인 이름을 추가하고 인덱스에 등록
+// name은 널 종료가 아니어도 됨
+tName *hash_insert( tNames *names, tIndex *index, const char *name, int name_len, char sex){
+	//적재율이 1/2을 넘으면 슬롯 수를 두배로
+	if((index->len + 1) * 2 > index->capacity) grow_index(index, names);
+	
+	unsigned int offset = pool_intern(&names->pool, name, name_len);
+	unsigned int mask = index->capacity - 1;
+	unsigned int h = hash_key(offset, sex) & mask;
+	
+	//빈 슬롯 또는 같은 키를 만날 때까지 선형 탐사
+	while(index->slot[h] != -1){
+		tName *cur = names->data + index->slot[h];
+		if(cur->offset == offset && cur->sex == sex) return cur;
+		h = (h + 1) & mask;
+	}
+	
+	//배열에 키가 존재하지 않을때 배열 끝에 추가
+	index->slot[h] = names->len;
+	index->len++;
+	return add_name(names, offset, name_len, sex);
+}
+
+// 해시탐색(hash search) 버전
+// 이름 배열은 정렬하지 않고 뒤에 추가만 하므로 qsort는 모든 파일을 읽은 후 한 번만 수행
+void load_names_hsearch( FILE *fp, int year_index, tNames *names, tIndex *index){
+	char* fLine = (char *)malloc(100);
+	while(fgets(fLine, 100, fp) != NULL){
+		//읽어온 줄에서 ','를 '\t'로 대체
+		char* ptr = strchr(fLine, ',');
+		while (ptr != NULL)
+		{
+			*ptr = '\t';
+			ptr = strchr(ptr + 1, ',');
+		}
+		
+		char curName[100] = "";
+		char curSex = 0;
+		int curFreq = 0;
+		
+		if(sscanf(fLine,"%s\t%c\t%d", curName, &curSex, &curFreq) != 3) continue;
+		
+		set_freq(names, hash_insert(names, index, curName, strlen(curName), curSex), year_index, curFreq);
+	}
+	free(fLine);
+}
+
+// "name,sex,count" 한 줄을 복사 없이 잘라냄
+// cur는 다음 줄의 시작으로 이동
+// return	1 한 줄을 읽음
+//			0 파일 끝
+static int _scan_line( const char **cur, const char *end, tView *view){
+	const char *p = *cur;
+	
+	while(1){
+		//빈 줄 건너뛰기
+		while(p < end && (*p == '\n' || *p == '\r')) p++;
+		if(p >= end) break;
+		
+		const char *line = p;
+		while(p < end && *p != ',' && *p != '\n') p++;
+		int name_len = p - line;
+		
+		//형식: 이름 ',' 성별 ',' 숫자
+		if(p + 2 < end && *p == ',' && p[2] == ',' && name_len > 0 && name_len <= 0xFFFF){
+			view->name = line;
+			view->name_len = name_len;
+			view->sex = p[1];
+			p += 3;
+			
+			int freq = 0;
+			while(p < end && *p >= '0' && *p <= '9') freq = freq * 10 + (*p++ - '0');
+			view->freq = freq;
+			
+			while(p < end && *p != '\n') p++;
+			*cur = p;
+			return 1;
+		}
+		
+		//형식에 맞지 않는 줄은 무시
+		while(p < end && *p != '\n') p++;
+	}
+	*cur = end;
+	return 0;
+}
+
+// mmap 버전 (해시탐색)
+// 파일 전체를 mmap한 후 _scan_line으로 잘라낸 키를 복사 없이 hash_insert에 바로 넘김
+void load_names_mmap( FILE *fp, int year_index, tNames *names, tIndex *index){
+	struct stat st;
+	if(fstat(fileno(fp), &st) != 0 || st.st_size == 0) return;
+	
+	const char *base = (const char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	if(base == MAP_FAILED){
+		fprintf( stderr, "mmap failed\n");
+		return;
+	}
+	madvise((void *)base, st.st_size, MADV_SEQUENTIAL);
+	
+	const char *cur = base;
+	const char *end = base + st.st_size;
+	tView view;
+	
+	while(_scan_line(&cur, end, &view)){
+		set_freq(names, hash_insert(names, index, view.name, view.name_len, view.sex), year_index, view.freq);
+	}
+	
+	munmap((void *)base, st.st_size);
+}
+
+// k-way merge 버전 (1단계)
+// 연도별 입력 파일 하나를 mmap하여 run에 저장한 후 (이름, 성별) 순으로 한 번 정렬
+void load_run( FILE *fp, int year_index, tRun *run){
+	struct stat st;
+	
+	run->len = 0;
+	run->capacity = 1024;
+	run->year_index = year_index;
+	run->data = (tView *)malloc(run->capacity * sizeof(tView));
+	run->base = NULL;
+	run->size = 0;
+	
+	if(fstat(fileno(fp), &st) != 0 || st.st_size == 0) return;
+	
+	run->base = (char *)mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	if(run->base == MAP_FAILED){
+		fprintf( stderr, "mmap failed\n");
+		run->base = NULL;
+		return;
+	}
+	run->size = st.st_size;
+	
+	const char *cur = run->base;
+	const char *end = run->base + run->size;
+	
+	while(1){
+		if(run->len == run->capacity){
+			run->data = (tView *)realloc(run->data, run->capacity * 2 * sizeof(tView));
+			run->capacity *= 2;
+		}
+		if(!_scan_line(&cur, end, run->data + run->len)) break;
+		run->len++;
+	}
+	
+	qsort( run->data, run->len, sizeof(tView), compare_view);
+}
+
+// run에 할당된 메모리와 mapping을 해제
+void destroy_run( tRun *run){
+	free(run->data);
+	if(run->base) munmap(run->base, run->size);
+	run->len = 0;
+	run->capacity = 0;
+}
+
+// 병합용 힙에서 run[a]의 현재 항목이 run[b]의 현재 항목보다 앞서는지 비교
+static int _run_less( tRun *runs, int *pos, int a, int b){
+	int ret = compare_view( &runs[a].data[pos[a]], &runs[b].data[pos[b]]);
+	if(ret == 0) return a < b;
+	return ret < 0;
+}
+
+// 병합용 힙(run 번호의 최소 힙)에서 index 위치의 원소를 아래로 내려 힙을 재구성
+static void _merge_heap_down( int *heap, int size, tRun *runs, int *pos, int index){
+	int top = heap[index];
+	while(index*2+1 < size){
+		int child = index*2+1;
+		if(child+1 < size && _run_less(runs, pos, heap[child+1], heap[child])) child++;
+		if(!_run_less(runs, pos, heap[child], top)) break;
+		heap[index] = heap[child];
+		index = child;
+	}
+	heap[index] = top;
+}
+
+// k-way merge 버전 (2단계)
+// 정렬된 run들을 힙으로 한 번에 병합하여 정렬된 이름 배열을 만듦
+// 같은 키는 연속해서 나오므로 freq[year_index]만 채우면 되고 validate가 필요 없음
+void merge_runs( tRun *runs, int num_runs, tNames *names){
+	int *heap = (int *)malloc(num_runs * sizeof(int));
+	int *pos = (int *)calloc(num_runs, sizeof(int));
+	int size = 0;
+	int total = 0;
+	
+	for(int i=0; i<num_runs; i++){
+		total += runs[i].len;
+		if(runs[i].len > 0) heap[size++] = i;
+	}
+	for(int i=size/2-1; i>=0; i--) _merge_heap_down(heap, size, runs, pos, i);
+	
+	//결과 배열의 크기는 모든 run의 항목 수를 넘지 않으므로 한 번에 할당
+	while(names->capacity < total) grow_names(names);
+	
+	tView *prev = NULL;
+	tName *last = NULL;
+	
+	while(size > 0){
+		int r = heap[0];
+		tView *cur = &runs[r].data[pos[r]];
+		
+		//직전에 추가한 이름과 다르면 새로 추가
+		if(prev == NULL || compare_view(prev, cur) != 0){
+			unsigned int offset = pool_intern(&names->pool, cur->name, cur->name_len);
+			last = add_name(names, offset, cur->name_len, cur->sex);
+		}
+		set_freq(names, last, runs[r].year_index, cur->freq);
+		prev = cur;
+		
+		//다 읽은 run은 힙에서 제거
+		if(++pos[r] == runs[r].len) heap[0] = heap[--size];
+		_merge_heap_down(heap, size, runs, pos, 0);
+	}
+	
+	free(heap);
+	free(pos);
+}
+
+// 작업자 스레드: 남은 파일을 하나씩 가져가 자신이 맡은 run을 채움
+// 각 run은 한 스레드만 쓰므로 next, error 외에는 잠금이 필요 없음
+static void *_load_worker( void *arg){
+	tJob *job = (tJob *)arg;
+	
+	while(1){
+		pthread_mutex_lock(&job->lock);
+		int i = job->next++;
+		pthread_mutex_unlock(&job->lock);
+		if(i >= job->num_files) break;
+		
+		char *file = job->files[i];
+		FILE *fp = fopen( file, "r");
+		if( !fp) {
+			fprintf( stderr, "cannot open file : %s\n", file);
+			pthread_mutex_lock(&job->lock);
+			job->error = 1;
+			pthread_mutex_unlock(&job->lock);
+			continue;
+		}
+		
+		int year = atoi( &file[strlen(file)-8]); // ex) "yob2009.txt" -> 2009
+		double start_time = get_time();
+		
+		load_run( fp, year - job->start_year, &job->runs[i]);
+		fclose( fp);
+		
+		fprintf( stderr, "Processing [%s].. %.3f sec\n", file, get_time() - start_time);
+	}
+	return NULL;
+}
+
+// 병렬 k-way merge 버전 (1단계)
+// num_threads개의 작업자 스레드가 파일을 하나씩 가져가 각자의 run에 load_run 수행
+// 2단계는 merge_runs로 한 번에 병합
+// return	1 성공
+//			0 열지 못한 파일이 있음
+int load_runs_parallel( char **files, int num_files, int start_year, int num_threads, tRun *runs){
+	tJob job;
+	job.files = files;
+	job.num_files = num_files;
+	job.start_year = start_year;
+	job.next = 0;
+	job.error = 0;
+	job.runs = runs;
+	pthread_mutex_init(&job.lock, NULL);
+	
+	//파일 수보다 많은 스레드는 필요 없음
+	if(num_threads > num_files) num_threads = num_files;
+	
+	pthread_t *threads = (pthread_t *)malloc(num_threads * sizeof(pthread_t));
+	for(int i=0; i<num_threads; i++){
+		pthread_create(&threads[i], NULL, _load_worker, &job);
+	}
+	for(int i=0; i<num_threads; i++){
+		pthread_join(threads[i], NULL);
+	}
+	free(threads);
+	pthread_mutex_destroy(&job.lock);
+	
+	return !job.error;
+}
+
+// 4바이트 단위 정렬을 위한 0 채우기
+static void _write_pad( FILE *fp, size_t written){
+	static const char zero[4] = {0, };
+	if(written % 4) fwrite(zero, 1, 4 - written % 4, fp);
+}
+
+// 정렬된 이름 구조체를 스냅샷 파일로 저장 (num_year개의 연도만 저장)
+// return	1 성공
+//			0 실패
+int save_snapshot( const char *path, tNames *names, int num_year){
+	FILE *fp = fopen( path, "wb");
+	if( !fp) return 0;
+	
+	//저장할 행 목록 (validate에서 'X'로 표시된 중복은 제외)
+	int *rows = (int *)malloc((names->len + 1) * sizeof(int));
+	int num_names = 0;
+	for(int i=0; i<names->len; i++){
+		if(names->data[i].sex == 'X') continue;
+		rows[num_names++] = i;
+	}
+	
+	tSnapHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SNAPSHOT_MAGIC, 8);
+	header.version = SNAPSHOT_VERSION;
+	header.num_names = num_names;
+	header.num_year = num_year;
+	header.pool_len = names->pool.len;
+	fwrite(&header, sizeof(header), 1, fp);
+	
+	//이름 위치 열
+	for(int i=0; i<num_names; i++){
+		fwrite(&names->data[rows[i]].offset, sizeof(unsigned int), 1, fp);
+	}
+	
+	//성별 열
+	for(int i=0; i<num_names; i++){
+		fwrite(&names->data[rows[i]].sex, 1, 1, fp);
+	}
+	_write_pad(fp, num_names);
+	
+	//문자열 블록
+	fwrite(names->pool.data, 1, names->pool.len, fp);
+	_write_pad(fp, names->pool.len);
+	
+	//freq 행렬 (열 우선, 행은 정렬 순서)
+	for(int j=0; j<num_year; j++){
+		for(int i=0; i<num_names; i++){
+			int freq = get_freq(names, &names->data[rows[i]], j);
+			fwrite(&freq, sizeof(int), 1, fp);
+		}
+	}
+	
+	free(rows);
+	return fclose(fp) == 0;
+}
+
+// 스냅샷 파일을 mmap하여 읽기 전용으로 엶 (다시 만들지 않고 mapping을 그대로 사용)
+// return	스냅샷 포인터
+//			NULL 파일이 없거나 형식/버전이 맞지 않음
+tSnapshot *load_snapshot( const char *path){
+	FILE *fp = fopen( path, "rb");
+	if( !fp) return NULL;
+	
+	struct stat st;
+	if(fstat(fileno(fp), &st) != 0 || (size_t)st.st_size < sizeof(tSnapHeader)){
+		fclose(fp);
+		return NULL;
+	}
+	
+	void *base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	fclose(fp);
+	if(base == MAP_FAILED) return NULL;
+	
+	const tSnapHeader *header = (const tSnapHeader *)base;
+	size_t num_names = header->num_names;
+	size_t sex_size = (num_names + 3) / 4 * 4;
+	size_t pool_size = ((size_t)header->pool_len + 3) / 4 * 4;
+	size_t expected = sizeof(tSnapHeader) + num_names * sizeof(unsigned int) + sex_size + pool_size
+					+ (size_t)header->num_year * num_names * sizeof(int);
+	
+	if(memcmp(header->magic, SNAPSHOT_MAGIC, 8) != 0 || header->version != SNAPSHOT_VERSION
+		|| (size_t)st.st_size != expected){
+		munmap(base, st.st_size);
+		return NULL;
+	}
+	
+	tSnapshot *snap = (tSnapshot *)malloc(sizeof(tSnapshot));
+	const char *p = (const char *)base + sizeof(tSnapHeader);
+	
+	snap->base = base;
+	snap->size = st.st_size;
+	snap->num_names = num_names;
+	snap->num_year = header->num_year;
+	snap->offset = (const unsigned int *)p;
+	p += num_names * sizeof(unsigned int);
+	snap->sex = p;
+	p += sex_size;
+	snap->pool = p;
+	p += pool_size;
+	snap->freq = (const int *)p;
+	
+	return snap;
+}
+
+// 스냅샷의 mapping을 해제
+void destroy_snapshot( tSnapshot *snap){
+	munmap(snap->base, snap->size);
+	free(snap);
+}
+
+// 스냅샷에서 (이름, 성별)을 이진탐색
+// return	행 번호
+//			-1 없음
+int find_snapshot( tSnapshot *snap, const char *name, char sex){
+	int lo = 0;
+	int hi = snap->num_names - 1;
+	
+	while(lo <= hi){
+		int mid = lo + (hi - lo) / 2;
+		int ret = strcmp(snap->pool + snap->offset[mid], name);
+		//이름이 같으면 성별순 ('F'가 'M'보다 앞)
+		if(ret == 0 && snap->sex[mid] != sex) ret = (snap->sex[mid] == 'M') ? 1 : -1;
+		
+		if(ret == 0) return mid;
+		else if(ret < 0) lo = mid + 1;
+		else hi = mid - 1;
+	}
+	return -1;
+}
+
+// 스냅샷의 한 행을 print_names와 같은 형식으로 출력
+void print_snapshot_row( tSnapshot *snap, int row){
+	printf("%s\t%c\t", snap->pool + snap->offset[row], snap->sex[row]);
+	for(int j = 0; j < snap->num_year; j++){
+		printf("%d\t", snap->freq[(size_t)j * snap->num_names + row]);
+	}
+	printf("\n");
+}
+
+// 스냅샷 전체를 print_names와 같은 형식으로 출력
+void print_snapshot( tSnapshot *snap){
+	for(int i = 0; i < snap->num_names; i++){
+		print_snapshot_row(snap, i);
+	}
+}
+
 // 구조체 배열을 화면에 출력
 void print_names( tNames *names, int num_year){
 	
 	for(int i = 0; i< names->len ; i++){
 		tName *curStruct = names->data+i; 
 		if(curStruct->sex == 'X') continue;
-		printf("%s\t%c\t", curStruct->name, curStruct->sex);
+		printf("%s\t%c\t", NAME_STR(names, curStruct), curStruct->sex);
 		for(int j = 0; j< num_year; j++){
-			printf("%d\t",curStruct->freq[j]);
+			printf("%d\t",get_freq(names, curStruct, j));
 		}
 		printf("\n");
 	}
@@ -265,11 +1051,12 @@ void print_names( tNames *names, int num_year){
 
 // qsort, bsearch를 위한 비교 함수
 // 정렬 기준 : 이름(1순위), 성별(2순위)
+// 이름 문자열은 g_pool(현재 이름 구조체의 풀)에서 찾음
 int compare( const void *n1, const void *n2){
 	tName *first = (tName *)n1;
 	tName *second = (tName *)n2;
 	
-	if(strcmp(first->name, second->name) == 0){
+	if(first->offset == second->offset){
 		if(first->sex == second->sex) return 0;
 		else if(first->sex == 'M'){
 			return 1;
@@ -279,30 +1066,146 @@ int compare( const void *n1, const void *n2){
 		}
 	}
 	else{
-		return strcmp(first->name, second->name);
+		return strcmp(g_pool + first->offset, g_pool + second->offset);
 	}
 }
 
+// 이름 배열을 정렬 (이름순 (이름이 같은 경우 성별순))
+void sort_names( tNames *names){
+	g_pool = names->pool.data;
+	qsort( names->data, names->len, sizeof(tName), compare);
+}
+
+// tView를 위한 비교 함수 (정렬 기준은 compare와 같음)
+int compare_view( const void *n1, const void *n2){
+	tView *first = (tView *)n1;
+	tView *second = (tView *)n2;
+	
+	int len = first->name_len < second->name_len ? first->name_len : second->name_len;
+	int ret = memcmp(first->name, second->name, len);
+	if(ret != 0) return ret;
+	if(first->name_len != second->name_len) return first->name_len - second->name_len;
+	if(first->sex == second->sex) return 0;
+	else if(first->sex == 'M') return 1;
+	else return -1;
+}
+
 void validate(tNames *names){
-	char curName[20];
-	char curSex;
-	int idx;
+	unsigned int curOffset = 0;
+	char curSex = 0;
+	int idx = -1;
 	for(int i=0; i<names->len; i++){
-		if(isSame(curName, curSex, &(names->data[i]))){
+		if(idx != -1 && isSame(curOffset, curSex, &(names->data[i]))){
 			names->data[i].sex = 'X';
-			for(int j=0;j<MAX_YEAR_DURATION;j++){
-				names->data[idx].freq[j] += names->data[i].freq[j];
+			for(int j=0;j<names->num_year;j++){
+				set_freq(names, &(names->data[idx]), j, get_freq(names, &(names->data[idx]), j) + get_freq(names, &(names->data[i]), j));
 			}
 		}
 		else{
-			strcpy(curName, names->data[i].name);
+			curOffset = names->data[i].offset;
 			curSex = names->data[i].sex;
 			idx = i;
 		}
 	}
 }
 
-int isSame(char *curName, char curSex, tName *name){
-	if(!strcmp(curName, name->name) && curSex == name->sex) return 1;
+int isSame(unsigned int curOffset, char curSex, tName *name){
+	if(curOffset == name->offset && curSex == name->sex) return 1;
 	else return 0;
-}
\ No newline at end of file
+}
+
+// 이름 문자열을 풀에 저장하고 풀에서의 위치를 반환
+// 이미 저장된 문자열이면 기존 위치를 반환 (str은 널 종료가 아니어도 됨)
+unsigned int pool_intern( tPool *pool, const char *str, int len){
+	//적재율이 1/2을 넘으면 슬롯 수를 두배로 하고 다시 채움
+	if((pool->num_keys + 1) * 2 > pool->slot_capacity){
+		unsigned int *old = pool->slot;
+		int old_capacity = pool->slot_capacity;
+		pool->slot_capacity *= 2;
+		pool->slot = (unsigned int *)calloc(pool->slot_capacity, sizeof(unsigned int));
+		
+		unsigned int mask = pool->slot_capacity - 1;
+		for(int i=0; i<old_capacity; i++){
+			if(old[i] == 0) continue;
+			const char *key = pool->data + old[i] - 1;
+			unsigned int h = hash_str(key, strlen(key)) & mask;
+			while(pool->slot[h] != 0) h = (h + 1) & mask;
+			pool->slot[h] = old[i];
+		}
+		free(old);
+	}
+	
+	unsigned int mask = pool->slot_capacity - 1;
+	unsigned int h = hash_str(str, len) & mask;
+	
+	//빈 슬롯 또는 같은 문자열을 만날 때까지 선형 탐사
+	while(pool->slot[h] != 0){
+		const char *key = pool->data + pool->slot[h] - 1;
+		if(key[len] == '\0' && !memcmp(key, str, len)) return pool->slot[h] - 1;
+		h = (h + 1) & mask;
+	}
+	
+	//풀 끝에 널 종료 문자열로 추가
+	while(pool->len + len + 1 > pool->capacity){
+		pool->data = (char *)realloc(pool->data, pool->capacity * 2);
+		pool->capacity *= 2;
+	}
+	unsigned int offset = pool->len;
+	memcpy(pool->data + offset, str, len);
+	pool->data[offset + len] = '\0';
+	pool->len += len + 1;
+	
+	pool->slot[h] = offset + 1;
+	pool->num_keys++;
+	return offset;
+}
+
+// 이름 배열과 freq 행렬의 용량을 두배로 늘림
+// freq 행렬은 열 우선이므로 열마다 새 위치로 옮김
+void grow_names( tNames *names){
+	int old_capacity = names->capacity;
+	names->capacity *= 2;
+	names->data = (tName *)realloc(names->data, names->capacity * sizeof(tName));
+	
+	if(names->num_year > 0){
+		int *freq = (int *)calloc((size_t)names->num_year * names->capacity, sizeof(int));
+		for(int j=0; j<names->num_year; j++){
+			memcpy(freq + (size_t)j * names->capacity, names->freq + (size_t)j * old_capacity, old_capacity * sizeof(int));
+		}
+		free(names->freq);
+		names->freq = freq;
+	}
+}
+
+// 이름 배열 끝에 빈도가 모두 0인 이름을 추가하고 그 주소를 반환
+tName *add_name( tNames *names, unsigned int offset, int len, char sex){
+	//len과 capacity가 같으면 capacity를 두배로 하고 data 배열을 재할당
+	if(names->len == names->capacity) grow_names(names);
+	
+	tName *curAdd = names->data + names->len;
+	curAdd->offset = offset;
+	curAdd->len = len;
+	curAdd->sex = sex;
+	curAdd->row = names->len;
+	names->len++;
+	return curAdd;
+}
+
+// 연도별 빈도를 저장
+// freq 행렬에 아직 없는 연도이면 열을 추가 (새 열은 0으로 초기화)
+void set_freq( tNames *names, tName *name, int year_index, int freq){
+	if(year_index < 0 || year_index >= MAX_YEAR_DURATION) return;
+	
+	if(year_index >= names->num_year){
+		names->freq = (int *)realloc(names->freq, (size_t)(year_index + 1) * names->capacity * sizeof(int));
+		memset(names->freq + (size_t)names->num_year * names->capacity, 0, (size_t)(year_index + 1 - names->num_year) * names->capacity * sizeof(int));
+		names->num_year = year_index + 1;
+	}
+	names->freq[(size_t)year_index * names->capacity + name->row] = freq;
+}
+
+// 연도별 빈도를 반환 (저장된 적 없는 연도는 0)
+int get_freq( tNames *names, tName *name, int year_index){
+	if(year_index < 0 || year_index >= names->num_year) return 0;
+	return names->freq[(size_t)year_index * names->capacity + name->row];
+}
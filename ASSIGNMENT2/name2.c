@@ -1,22 +1,82 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h> // clock
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
 
-#define MAX_YEAR_DURATION	10	// 기간
+#define MAX_YEAR_DURATION	140	// 최대 기간 (freq 행렬의 열은 필요한 만큼만 할당)
+#define BLOCK_SIZE			256	// 블록 하나에 저장하는 이름의 수 (12바이트 x 256 = 3KB)
+
+// 이름 문자열 풀 (interned string arena)
+// 모든 이름을 널 종료 문자열로 이어 붙여 저장하고, 같은 이름은 한 번만 저장
+typedef struct {
+	int		len;			// 풀에 저장된 바이트 수
+	int		capacity;		// 풀의 용량 (바이트)
+	char	*data;			// 문자열 풀의 포인터
+	int		num_keys;		// 풀에 저장된 문자열의 수
+	int		slot_capacity;	// 해시 슬롯의 수 (2의 거듭제곱)
+	unsigned int *slot;		// 문자열의 위치 + 1, 빈 슬롯은 0
+} tPool;
 
 // 구조체 선언
+// 이름 문자열은 풀에, 연도별 빈도는 열 우선(column-major) 행렬에 따로 저장
+// 정렬을 위해 memmove로 옮기는 것은 이 작은 레코드뿐임
 typedef struct {
-	char	name[20];		// 이름
-	char	sex;			// 성별 M or F
-	int		freq[MAX_YEAR_DURATION]; // 연도별 빈도
+	unsigned int	offset;	// 풀에서 이름의 위치
+	unsigned short	len;	// 이름의 길이
+	char			sex;	// 성별 M or F
+	int				row;	// freq 행렬에서의 행 번호
 } tName;
 
+// 정렬된 블록
+// 블록 안의 이름은 정렬되어 있고, 블록을 순서대로 이어 붙이면 전체가 정렬됨
+// 삽입할 때는 블록 하나 안에서만 memmove 하고, 블록이 가득 차면 둘로 나눔
+typedef struct {
+	int		len;				// 블록에 저장된 이름의 수
+	tName	data[BLOCK_SIZE];	// 이름 배열
+} tBlock;
+
 typedef struct {
-	int		len;		// 배열에 저장된 이름의 수
-	int		capacity;	// 배열의 용량 (배열에 저장 가능한 이름의 수)
-	tName	*data;		// 이름 배열의 포인터
+	int		len;			// 저장된 이름의 수
+	int		capacity;		// freq 행렬의 행 수 (저장 가능한 이름의 수)
+	int		num_blocks;		// 블록의 수
+	int		block_capacity;	// 블록 포인터 배열의 용량
+	tBlock	**blocks;		// 블록 포인터 배열 (상위 인덱스, 블록 순서대로)
+	tPool	pool;		// 이름 문자열 풀
+	int		num_year;	// freq 행렬의 열 수
+	int		*freq;		// 연도별 빈도 행렬, freq[year_index * capacity + row]
 } tNames;
 
+// 스냅샷 파일 헤더
+// 헤더 뒤에는 이름 위치 열(unsigned int x num_names), 성별 열(char x num_names),
+// 문자열 블록(pool_len 바이트), freq 행렬(int x num_year x num_names, 열 우선)이
+// 차례로 저장되며 각 구역은 4바이트 단위로 정렬됨
+// 행은 이름순 (이름이 같은 경우 성별순)으로 정렬되어 있음
+#define SNAPSHOT_MAGIC		"NAMESNAP"
+#define SNAPSHOT_VERSION	1
+
+typedef struct {
+	char			magic[8];	// SNAPSHOT_MAGIC
+	unsigned int	version;	// SNAPSHOT_VERSION
+	unsigned int	num_names;	// 이름의 수 (행의 수)
+	unsigned int	num_year;	// 연도의 수 (열의 수)
+	unsigned int	pool_len;	// 문자열 블록의 크기 (바이트)
+} tSnapHeader;
+
+// mmap된 스냅샷 파일 (모든 포인터는 mapping 안을 가리킴)
+typedef struct {
+	void				*base;		// mapping의 시작 위치
+	size_t				size;		// mapping의 크기
+	int					num_names;	// 이름의 수
+	int					num_year;	// 연도의 수
+	const unsigned int	*offset;	// 이름 위치 열 (문자열 블록 안의 위치)
+	const char			*sex;		// 성별 열
+	const char			*pool;		// 문자열 블록
+	const int			*freq;		// freq 행렬, freq[year_index * num_names + row]
+	int					*eyt;		// Eytzinger 순서의 행 번호 (1부터, 처음 검색할 때 만듦)
+} tSnapshot;
+
 // 함수 원형 선언
 
 // 연도별 입력 파일을 읽어 이름 정보(연도, 이름, 성별, 빈도)를 이름 구조체에 저장
@@ -24,11 +84,41 @@ typedef struct {
 // 새로 등장한 이름은 구조체에 추가
 // 주의사항: 동일 이름이 남/여 각각 사용될 수 있으므로, 이름과 성별을 구별해야 함
 // 주의사항: 정렬 리스트(ordered list)를 유지해야 함 (qsort 함수 사용하지 않음)
-// 이미 등장한 이름인지 검사하기 위해 bsearch 함수를 사용
-// 새로운 이름을 저장할 메모리 공간을 확보하기 위해 memmove 함수를 이용하여 메모리에 저장된 내용을 복사
+// 상위 인덱스에서 블록을 찾은 후 블록 안에서 lower_bound_name 함수를 사용
+// 새로운 이름을 저장할 메모리 공간을 확보하기 위해 memmove 함수를 이용하여 블록 안의 내용만 복사
 // names->capacity는 2배씩 증가
 void load_names( FILE *fp, int start_year, tNames *names);
 
+// key가 들어 있거나 들어가야 할 블록의 번호
+// 첫 이름이 key보다 크지 않은 마지막 블록 (없으면 0번 블록)
+int find_block( tNames *names, const tName *key);
+
+// 가득 찬 b번 블록의 뒤쪽 절반을 새 블록으로 옮겨 b+1번에 끼워넣음
+void split_block( tNames *names, int b);
+
+// 정렬된 이름 구조체를 스냅샷 파일로 저장 (num_year개의 연도만 저장)
+// return	1 성공
+//			0 실패
+int save_snapshot( const char *path, tNames *names, int num_year);
+
+// 스냅샷 파일을 mmap하여 읽기 전용으로 엶 (다시 만들지 않고 mapping을 그대로 사용)
+// return	스냅샷 포인터
+//			NULL 파일이 없거나 형식/버전이 맞지 않음
+tSnapshot *load_snapshot( const char *path);
+
+// 스냅샷의 mapping을 해제
+void destroy_snapshot( tSnapshot *snap);
+
+// 스냅샷에서 (이름, 성별)을 Eytzinger 배치로 탐색
+// 처음 호출될 때 행 번호를 Eytzinger 순서로 배치한 인덱스를 만듦
+// return	행 번호
+//			-1 없음
+int find_snapshot( tSnapshot *snap, const char *name, char sex);
+
+// 스냅샷의 한 행 / 전체를 print_names와 같은 형식으로 출력
+void print_snapshot_row( tSnapshot *snap, int row);
+void print_snapshot( tSnapshot *snap);
+
 // 구조체 배열을 화면에 출력
 void print_names( tNames *names, int num_year);
 
@@ -40,6 +130,69 @@ int compare( const void *n1, const void *n2);
 //				key가 발견되지 않는 경우, key가 삽입되어야 할 배열의 인덱스
 int binary_search( const void *key, const void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *));
 
+// lower bound 함수 (정렬된 배열에서 key보다 작지 않은 첫 원소의 인덱스, 없으면 nmemb)
+// 모든 버전은 bsearch와 같은 비교 함수를 사용
+// 기본 버전
+size_t lower_bound( const void *key, const void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *));
+
+// 분기 없는(branchless) 버전
+// 구간을 항상 절반으로 줄이고 비교 결과는 조건부 이동으로만 사용
+size_t lower_bound_branchless( const void *key, const void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *));
+
+// 정렬된 배열 sorted를 Eytzinger(BFS) 순서로 out에 배치
+// out은 nmemb+1개의 원소 크기, out[0]은 사용하지 않음 (1부터 시작)
+void eytzinger_build( const void *sorted, size_t nmemb, size_t size, void *out);
+
+// Eytzinger 버전 (읽기 위주의 배열용)
+// return	lower bound 원소의 Eytzinger 인덱스 (1부터)
+//			0 모든 원소가 key보다 작음
+size_t lower_bound_eytzinger( const void *key, const void *eyt, size_t nmemb, size_t size, int (*compare)(const void *, const void *));
+
+// 모든 lower bound 함수(compare 사용)의 결과를 lower_bound_name과 비교
+// 이름 구조체의 모든 (이름, 성별)과 성별만 바꾼 키를 찾아봄
+// return	결과가 다른 키의 수
+int check_search( tNames *names);
+
+// 이름 문자열을 풀에 저장하고 풀에서의 위치를 반환
+// 이미 저장된 문자열이면 기존 위치를 반환
+unsigned int pool_intern( tPool *pool, const char *str, int len);
+
+// 연도별 빈도를 저장/반환
+void set_freq( tNames *names, tName *name, int year_index, int freq);
+int get_freq( tNames *names, tName *name, int year_index);
+
+// freq 행렬의 행 수를 두배로 늘림
+void grow_names( tNames *names);
+
+// 이름 문자열의 주소
+#define NAME_STR(names, p)	((names)->pool.data + (p)->offset)
+
+// compare 함수에서 이름 문자열을 찾을 풀 (bsearch 호출 전에 설정)
+static const char *g_pool;
+
+// (이름, 성별) 비교 함수 (compare와 같은 순서)
+// 함수 포인터와 g_pool 없이 호출되는 곳에 인라인되는 전용 버전
+static inline int compare_name( const char *pool, const tName *first, const tName *second){
+	if(first->offset == second->offset){
+		if(first->sex == second->sex) return 0;
+		return (first->sex == 'M') ? 1 : -1;
+	}
+	return strcmp(pool + first->offset, pool + second->offset);
+}
+
+// lower bound 함수 (분기 없는 버전, compare_name 전용)
+static inline int lower_bound_name( const char *pool, const tName *key, const tName *base, int nmemb){
+	if(nmemb == 0) return 0;
+	
+	const tName *first = base;
+	while(nmemb > 1){
+		int half = nmemb / 2;
+		first = (compare_name(pool, first + half, key) < 0) ? first + half : first;
+		nmemb -= half;
+	}
+	return (first - base) + (compare_name(pool, first, key) < 0);
+}
+
 // 함수 정의
 
 // 이름 구조체 초기화
@@ -51,7 +204,23 @@ tNames *create_names()
 	
 	pnames->len = 0;
 	pnames->capacity = 1;
-	pnames->data = (tName *)malloc(pnames->capacity * sizeof(tName));
+	
+	//빈 블록 하나로 시작
+	pnames->num_blocks = 1;
+	pnames->block_capacity = 16;
+	pnames->blocks = (tBlock **)malloc(pnames->block_capacity * sizeof(tBlock *));
+	pnames->blocks[0] = (tBlock *)malloc(sizeof(tBlock));
+	pnames->blocks[0]->len = 0;
+	
+	pnames->num_year = 0;
+	pnames->freq = NULL;
+	
+	pnames->pool.len = 0;
+	pnames->pool.capacity = 1024;
+	pnames->pool.data = (char *)malloc(pnames->pool.capacity);
+	pnames->pool.num_keys = 0;
+	pnames->pool.slot_capacity = 1024;
+	pnames->pool.slot = (unsigned int *)calloc(pnames->pool.slot_capacity, sizeof(unsigned int));
 
 	return pnames;
 }
@@ -59,7 +228,11 @@ tNames *create_names()
 // 이름 구조체에 할당된 메모리를 해제
 void destroy_names(tNames *pnames)
 {
-	free(pnames->data);
+	for(int i=0; i<pnames->num_blocks; i++) free(pnames->blocks[i]);
+	free(pnames->blocks);
+	free(pnames->freq);
+	free(pnames->pool.data);
+	free(pnames->pool.slot);
 	pnames->len = 0;
 	pnames->capacity = 0;
 
@@ -72,9 +245,66 @@ int main(int argc, char **argv)
 	tNames *names;
 	FILE *fp;
 	
+	// 스냅샷 모드: 텍스트 파일을 읽지 않고 스냅샷 파일을 mmap하여 바로 출력
+	// 이름/성별(ex. "Zoe/F")이 주어지면 해당 이름만 찾아서 출력
+	if (argc >= 3 && strcmp( argv[1], "--load") == 0)
+	{
+		tSnapshot *snap = load_snapshot( argv[2]);
+		if (!snap)
+		{
+			fprintf( stderr, "cannot load snapshot : %s\n", argv[2]);
+			return 1;
+		}
+		
+		if (argc == 3) print_snapshot( snap);
+		
+		for (int i = 3; i < argc; i++)
+		{
+			char key[100];
+			strncpy( key, argv[i], sizeof(key)-1);
+			key[sizeof(key)-1] = '\0';
+			
+			char *p = strchr( key, '/');
+			int row = -1;
+			if (p)
+			{
+				*p = '\0';
+				row = find_snapshot( snap, key, p[1]);
+			}
+			
+			if (row != -1) print_snapshot_row( snap, row);
+			else fprintf( stdout, "%s not found\n", argv[i]);
+		}
+		
+		destroy_snapshot( snap);
+		return 0;
+	}
+	
+	// --save SNAPSHOT이 주어지면 결과를 스냅샷 파일로도 저장
+	char *save_file = NULL;
+	if (argc > 3 && strcmp( argv[1], "--save") == 0)
+	{
+		save_file = argv[2];
+		argv[2] = argv[0];
+		argv += 2;
+		argc -= 2;
+	}
+	
+	// --check이 주어지면 출력 대신 lower bound 함수들을 검사
+	int check = 0;
+	if (argc == 3 && strcmp( argv[1], "--check") == 0)
+	{
+		check = 1;
+		argv[1] = argv[0];
+		argv++;
+		argc--;
+	}
+
 	if (argc != 2)
 	{
-		fprintf( stderr, "Usage: %s FILE\n\n", argv[0]);
+		fprintf( stderr, "Usage: %s [--save SNAPSHOT] FILE\n", argv[0]);
+		fprintf( stderr, "       %s --load SNAPSHOT [NAME/SEX...]\n", argv[0]);
+		fprintf( stderr, "       %s --check FILE\n\n", argv[0]);
 		return 1;
 	}
 
@@ -88,15 +318,31 @@ int main(int argc, char **argv)
 		return 1;
 	}
 
-	fprintf( stderr, "Processing [%s]..\n", argv[1]);
+	fprintf( stderr, "Processing [%s]..", argv[1]);
+	clock_t start = clock();
 		
 	// 연도별 입력 파일(이름 정보)을 구조체에 저장
 	load_names( fp, 2009, names);
 	
 	fclose( fp);
 	
+	fprintf( stderr, " %.3f sec\n", (double)(clock() - start) / CLOCKS_PER_SEC);
+	
+	// 스냅샷 파일로 저장
+	if (save_file && !save_snapshot( save_file, names, names->num_year))
+	{
+		fprintf( stderr, "cannot save snapshot : %s\n", save_file);
+	}
+	
+	if (check)
+	{
+		int errors = check_search( names);
+		destroy_names( names);
+		return errors ? 1 : 0;
+	}
+	
 	// 이름 구조체를 화면에 출력
-	print_names( names, MAX_YEAR_DURATION);
+	print_names( names, names->num_year);
 	
 	// 이름 구조체 해제
 	destroy_names( names);
@@ -109,8 +355,8 @@ int main(int argc, char **argv)
 // 새로 등장한 이름은 구조체에 추가
 // 주의사항: 동일 이름이 남/여 각각 사용될 수 있으므로, 이름과 성별을 구별해야 함
 // 주의사항: 정렬 리스트(ordered list)를 유지해야 함 (qsort 함수 사용하지 않음)
-// 이미 등장한 이름인지 검사하기 위해 bsearch 함수를 사용
-// 새로운 이름을 저장할 메모리 공간을 확보하기 위해 memmove 함수를 이용하여 메모리에 저장된 내용을 복사
+// 상위 인덱스에서 블록을 찾은 후 블록 안에서 lower_bound_name 함수를 사용
+// 새로운 이름을 저장할 메모리 공간을 확보하기 위해 memmove 함수를 이용하여 블록 안의 내용만 복사
 // names->capacity는 2배씩 증가
 void load_names( FILE *fp, int start_year, tNames *names){
 	char* fLine = (char *)malloc(100);
@@ -118,74 +364,383 @@ void load_names( FILE *fp, int start_year, tNames *names){
 		
 		int year_index = 0;
 		int curFreq = 0;
+		char curName[100] = "";
 		tName tempData;
-		memset(tempData.freq, 0, sizeof(int) * MAX_YEAR_DURATION);
 		
 		fgets(fLine, 100 , fp);
-		sscanf(fLine,"%d %s %c %d", &year_index, tempData.name, &(tempData.sex), &curFreq);
+		sscanf(fLine,"%d %s %c %d", &year_index, curName, &(tempData.sex), &curFreq);
+		
+		//이름을 먼저 풀에 저장해 두면 tempData를 bsearch의 키로 쓸 수 있음
+		tempData.len = strlen(curName);
+		tempData.offset = pool_intern(&names->pool, curName, tempData.len);
+		g_pool = names->pool.data;
 		
-		int idx = binary_search( &tempData, names->data, names->len, sizeof(tName), compare);
+		int b = find_block( names, &tempData);
+		tBlock *block = names->blocks[b];
+		int idx = lower_bound_name( names->pool.data, &tempData, block->data, block->len);
 		
 		//이미 키가 존재할 때
-		if(bsearch( &tempData, names->data, names->len, sizeof(tName), compare) != NULL){
-			(names->data)[idx].freq[year_index-start_year] = curFreq;
+		if(idx < block->len && compare_name( names->pool.data, &tempData, &(block->data)[idx]) == 0){
+			set_freq(names, &(block->data)[idx], year_index-start_year, curFreq);
 		}
-		else{ // idx 위치에 새로 데이터를 끼워넣을 때
+		else{ // b번 블록의 idx 위치에 새로 데이터를 끼워넣을 때
 			
-			//len과 capacity가 같으면 capacity를 두배로 하고 data 배열을 재할당
+			//len과 capacity가 같으면 capacity를 두배로 하고 freq 행렬을 재할당
 			if(names->len == names->capacity){
-				names->data = (tName *)realloc(names->data,names->capacity * 2 * sizeof(tName));
-				names->capacity *= 2;
+				grow_names(names);
+			}
+			
+			//블록이 가득 차면 둘로 나누고 idx가 속한 쪽에 삽입
+			if(block->len == BLOCK_SIZE){
+				split_block(names, b);
+				if(idx > BLOCK_SIZE/2){
+					idx -= BLOCK_SIZE/2;
+					b++;
+				}
+				block = names->blocks[b];
 			}
 			
-			if(names->len != 0)
-				memmove( &(names->data)[idx+1], &(names->data)[idx], sizeof(tName) * ((names->len)-idx));
+			memmove( &(block->data)[idx+1], &(block->data)[idx], sizeof(tName) * ((block->len)-idx));
 			
-			strcpy((names->data)[idx].name, tempData.name);
-			(names->data)[idx].sex = tempData.sex;
-			memset((names->data)[idx].freq, 0, sizeof(int) * MAX_YEAR_DURATION);
-			(names->data)[idx].freq[year_index-start_year] = curFreq;
+			(block->data)[idx] = tempData;
+			(block->data)[idx].row = names->len; // 새 행은 0으로 초기화되어 있음
+			set_freq(names, &(block->data)[idx], year_index-start_year, curFreq);
+			block->len += 1;
 			names->len += 1;
 		}
 	}
 	free(fLine);
 }
 
+// key가 들어 있거나 들어가야 할 블록의 번호
+// 첫 이름이 key보다 크지 않은 마지막 블록 (없으면 0번 블록)
+int find_block( tNames *names, const tName *key){
+	int lo = 1;
+	int hi = names->num_blocks - 1;
+	int found = 0;
+	
+	while(lo <= hi){
+		int mid = lo + (hi - lo) / 2;
+		if(compare_name(names->pool.data, &(names->blocks[mid]->data)[0], key) <= 0){
+			found = mid;
+			lo = mid + 1;
+		}
+		else hi = mid - 1;
+	}
+	return found;
+}
+
+// 가득 찬 b번 블록의 뒤쪽 절반을 새 블록으로 옮겨 b+1번에 끼워넣음
+void split_block( tNames *names, int b){
+	if(names->num_blocks == names->block_capacity){
+		names->blocks = (tBlock **)realloc(names->blocks, names->block_capacity * 2 * sizeof(tBlock *));
+		names->block_capacity *= 2;
+	}
+	
+	tBlock *block = names->blocks[b];
+	tBlock *newBlock = (tBlock *)malloc(sizeof(tBlock));
+	
+	newBlock->len = block->len - BLOCK_SIZE/2;
+	memcpy(newBlock->data, &(block->data)[BLOCK_SIZE/2], sizeof(tName) * newBlock->len);
+	block->len = BLOCK_SIZE/2;
+	
+	memmove(&(names->blocks)[b+2], &(names->blocks)[b+1], sizeof(tBlock *) * (names->num_blocks - b - 1));
+	names->blocks[b+1] = newBlock;
+	names->num_blocks++;
+}
+
 // 이진탐색 함수
 // return value: key가 발견되는 경우, 배열의 인덱스
 //				key가 발견되지 않는 경우, key가 삽입되어야 할 배열의 인덱스
 int binary_search( const void *key, const void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *)){
+	return lower_bound(key, base, nmemb, size, compare);
+}
+
+// lower bound 함수 (기본 버전)
+size_t lower_bound( const void *key, const void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *)){
+	size_t lo = 0;
+	size_t hi = nmemb;
 	
-	if(bsearch(key,base,nmemb,size,compare) != NULL) return (bsearch(key,base,nmemb,size,compare)- base) / sizeof(tName) ;
-	else{
-		for(int i=0; i<nmemb; i++){
-			if(compare(key, base+(sizeof(tName) * i)) < 0){
-				return i;
-			}
+	while(lo < hi){
+		size_t mid = lo + (hi - lo) / 2;
+		if(compare((const char *)base + mid * size, key) < 0) lo = mid + 1;
+		else hi = mid;
+	}
+	return lo;
+}
+
+// lower bound 함수 (분기 없는 버전)
+size_t lower_bound_branchless( const void *key, const void *base, size_t nmemb, size_t size, int (*compare)(const void *, const void *)){
+	if(nmemb == 0) return 0;
+	
+	const char *first = (const char *)base;
+	while(nmemb > 1){
+		size_t half = nmemb / 2;
+		first = (compare(first + half * size, key) < 0) ? first + half * size : first;
+		nmemb -= half;
+	}
+	return (first - (const char *)base) / size + (compare(first, key) < 0);
+}
+
+// 중위 순회 순서대로 sorted의 원소를 Eytzinger 위치 k에 채움
+static void _eytzinger_fill( const char *sorted, size_t *i, size_t k, size_t nmemb, size_t size, char *out){
+	if(k > nmemb) return;
+	_eytzinger_fill(sorted, i, 2 * k, nmemb, size, out);
+	memcpy(out + k * size, sorted + (*i)++ * size, size);
+	_eytzinger_fill(sorted, i, 2 * k + 1, nmemb, size, out);
+}
+
+// 정렬된 배열 sorted를 Eytzinger(BFS) 순서로 out에 배치
+void eytzinger_build( const void *sorted, size_t nmemb, size_t size, void *out){
+	size_t i = 0;
+	_eytzinger_fill((const char *)sorted, &i, 1, nmemb, size, (char *)out);
+}
+
+// lower bound 함수 (Eytzinger 버전)
+// 자식 위치가 2k, 2k+1이므로 위쪽 단계들이 몇 개의 캐시 라인에 모여 있음
+size_t lower_bound_eytzinger( const void *key, const void *eyt, size_t nmemb, size_t size, int (*compare)(const void *, const void *)){
+	size_t k = 1;
+	while(k <= nmemb){
+		k = 2 * k + (compare((const char *)eyt + k * size, key) < 0);
+	}
+	//마지막으로 왼쪽으로 내려간 위치까지 되돌아감
+	while(k & 1) k >>= 1;
+	return k >> 1;
+}
+
+// 모든 lower bound 함수(compare 사용)의 결과를 lower_bound_name과 비교
+// 블록들을 하나의 정렬된 배열로 이어 붙인 뒤, 그 배열의 Eytzinger 배치도 함께 검사
+int check_search( tNames *names){
+	size_t n = names->len;
+	tName *sorted = (tName *)malloc(sizeof(tName) * (n + 1));
+	tName *eyt = (tName *)malloc(sizeof(tName) * (n + 1));
+	int errors = 0;
+	int keys = 0;
+	
+	size_t len = 0;
+	for(int b = 0; b < names->num_blocks; b++){
+		memcpy(sorted + len, names->blocks[b]->data, sizeof(tName) * names->blocks[b]->len);
+		len += names->blocks[b]->len;
+	}
+	eytzinger_build(sorted, n, sizeof(tName), eyt);
+	g_pool = names->pool.data;
+	
+	for(size_t i = 0; i < n; i++){
+		//저장된 키와 성별만 바꾼 키 (없는 키면 삽입 위치를 비교)
+		for(int flip = 0; flip < 2; flip++){
+			tName key = sorted[i];
+			if(flip) key.sex = (key.sex == 'M') ? 'F' : 'M';
+			keys++;
+			
+			size_t expected = lower_bound_name(names->pool.data, &key, sorted, n);
+			if(lower_bound(&key, sorted, n, sizeof(tName), compare) != expected) errors++;
+			if(lower_bound_branchless(&key, sorted, n, sizeof(tName), compare) != expected) errors++;
+			if((size_t)binary_search(&key, sorted, n, sizeof(tName), compare) != expected) errors++;
+			
+			//Eytzinger 결과는 같은 원소를 가리키는지 비교 (0은 모든 원소가 key보다 작음)
+			size_t k = lower_bound_eytzinger(&key, eyt, n, sizeof(tName), compare);
+			if(k == 0 ? expected != n : (expected == n || compare(&eyt[k], &sorted[expected]) != 0)) errors++;
+		}
+	}
+	
+	fprintf(stdout, "checked %d keys over %zu names (lower_bound, lower_bound_branchless, binary_search, lower_bound_eytzinger against lower_bound_name): %d errors\n",
+		keys, n, errors);
+	
+	free(sorted);
+	free(eyt);
+	return errors;
+}
+
+// 4바이트 단위 정렬을 위한 0 채우기
+static void _write_pad( FILE *fp, size_t written){
+	static const char zero[4] = {0, };
+	if(written % 4) fwrite(zero, 1, 4 - written % 4, fp);
+}
+
+// 정렬된 이름 구조체를 스냅샷 파일로 저장 (num_year개의 연도만 저장)
+// return	1 성공
+//			0 실패
+int save_snapshot( const char *path, tNames *names, int num_year){
+	FILE *fp = fopen( path, "wb");
+	if( !fp) return 0;
+	
+	//저장할 행 목록 (블록 순서대로)
+	tName **rows = (tName **)malloc((names->len + 1) * sizeof(tName *));
+	int num_names = 0;
+	for(int b=0; b<names->num_blocks; b++){
+		for(int i=0; i<names->blocks[b]->len; i++){
+			rows[num_names++] = &(names->blocks[b]->data)[i];
 		}
 	}
-	return nmemb;
+	
+	tSnapHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, SNAPSHOT_MAGIC, 8);
+	header.version = SNAPSHOT_VERSION;
+	header.num_names = num_names;
+	header.num_year = num_year;
+	header.pool_len = names->pool.len;
+	fwrite(&header, sizeof(header), 1, fp);
+	
+	//이름 위치 열
+	for(int i=0; i<num_names; i++){
+		fwrite(&rows[i]->offset, sizeof(unsigned int), 1, fp);
+	}
+	
+	//성별 열
+	for(int i=0; i<num_names; i++){
+		fwrite(&rows[i]->sex, 1, 1, fp);
+	}
+	_write_pad(fp, num_names);
+	
+	//문자열 블록
+	fwrite(names->pool.data, 1, names->pool.len, fp);
+	_write_pad(fp, names->pool.len);
+	
+	//freq 행렬 (열 우선, 행은 정렬 순서)
+	for(int j=0; j<num_year; j++){
+		for(int i=0; i<num_names; i++){
+			int freq = get_freq(names, rows[i], j);
+			fwrite(&freq, sizeof(int), 1, fp);
+		}
+	}
+	
+	free(rows);
+	return fclose(fp) == 0;
+}
+
+// 스냅샷 파일을 mmap하여 읽기 전용으로 엶 (다시 만들지 않고 mapping을 그대로 사용)
+// return	스냅샷 포인터
+//			NULL 파일이 없거나 형식/버전이 맞지 않음
+tSnapshot *load_snapshot( const char *path){
+	FILE *fp = fopen( path, "rb");
+	if( !fp) return NULL;
+	
+	struct stat st;
+	if(fstat(fileno(fp), &st) != 0 || (size_t)st.st_size < sizeof(tSnapHeader)){
+		fclose(fp);
+		return NULL;
+	}
+	
+	void *base = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+	fclose(fp);
+	if(base == MAP_FAILED) return NULL;
+	
+	const tSnapHeader *header = (const tSnapHeader *)base;
+	size_t num_names = header->num_names;
+	size_t sex_size = (num_names + 3) / 4 * 4;
+	size_t pool_size = ((size_t)header->pool_len + 3) / 4 * 4;
+	size_t expected = sizeof(tSnapHeader) + num_names * sizeof(unsigned int) + sex_size + pool_size
+					+ (size_t)header->num_year * num_names * sizeof(int);
+	
+	if(memcmp(header->magic, SNAPSHOT_MAGIC, 8) != 0 || header->version != SNAPSHOT_VERSION
+		|| (size_t)st.st_size != expected){
+		munmap(base, st.st_size);
+		return NULL;
+	}
+	
+	tSnapshot *snap = (tSnapshot *)malloc(sizeof(tSnapshot));
+	const char *p = (const char *)base + sizeof(tSnapHeader);
+	
+	snap->base = base;
+	snap->size = st.st_size;
+	snap->num_names = num_names;
+	snap->num_year = header->num_year;
+	snap->offset = (const unsigned int *)p;
+	p += num_names * sizeof(unsigned int);
+	snap->sex = p;
+	p += sex_size;
+	snap->pool = p;
+	p += pool_size;
+	snap->freq = (const int *)p;
+	snap->eyt = NULL;
+	
+	return snap;
+}
+
+// 스냅샷의 mapping을 해제
+void destroy_snapshot( tSnapshot *snap){
+	munmap(snap->base, snap->size);
+	free(snap->eyt);
+	free(snap);
+}
+
+// 스냅샷의 row번 행과 (이름, 성별) 비교 (compare와 같은 순서)
+static inline int _compare_row( tSnapshot *snap, int row, const char *name, char sex){
+	int ret = strcmp(snap->pool + snap->offset[row], name);
+	//이름이 같으면 성별순 ('F'가 'M'보다 앞)
+	if(ret == 0 && snap->sex[row] != sex) ret = (snap->sex[row] == 'M') ? 1 : -1;
+	return ret;
+}
+
+// 스냅샷에서 (이름, 성별)을 Eytzinger 배치로 탐색 (lower_bound_eytzinger와 같은 방식)
+// return	행 번호
+//			-1 없음
+int find_snapshot( tSnapshot *snap, const char *name, char sex){
+	size_t n = snap->num_names;
+	
+	//처음 검색할 때 행 번호를 Eytzinger 순서로 배치
+	if(snap->eyt == NULL){
+		int *rows = (int *)malloc((n + 1) * sizeof(int));
+		for(size_t i=0; i<n; i++) rows[i] = i;
+		snap->eyt = (int *)malloc((n + 1) * sizeof(int));
+		eytzinger_build(rows, n, sizeof(int), snap->eyt);
+		free(rows);
+	}
+	
+	size_t k = 1;
+	while(k <= n){
+		k = 2 * k + (_compare_row(snap, snap->eyt[k], name, sex) < 0);
+	}
+	//마지막으로 왼쪽으로 내려간 위치까지 되돌아감
+	while(k & 1) k >>= 1;
+	k >>= 1;
+	
+	if(k == 0 || _compare_row(snap, snap->eyt[k], name, sex) != 0) return -1;
+	return snap->eyt[k];
+}
+
+// 스냅샷의 한 행을 print_names와 같은 형식으로 출력
+void print_snapshot_row( tSnapshot *snap, int row){
+	printf("%s\t%c\t", snap->pool + snap->offset[row], snap->sex[row]);
+	printf("%d", snap->num_year > 0 ? snap->freq[row] : 0);
+	for(int j = 1; j < snap->num_year; j++){
+		printf("\t%d", snap->freq[(size_t)j * snap->num_names + row]);
+	}
+	printf("\n");
+}
+
+// 스냅샷 전체를 print_names와 같은 형식으로 출력
+void print_snapshot( tSnapshot *snap){
+	for(int i = 0; i < snap->num_names; i++){
+		print_snapshot_row(snap, i);
+	}
 }
 
 // 구조체 배열을 화면에 출력
 void print_names( tNames *names, int num_year){
 	
-	for(int i = 0; i< names->len ; i++){
-		printf("%s\t%c\t", (names->data)[i].name, (names->data)[i].sex);
-		printf("%d",(names->data)[i].freq[0]);
-		for(int j = 1; j< num_year; j++){
-			printf("\t%d",(names->data)[i].freq[j]);
+	for(int b = 0; b < names->num_blocks; b++){
+		tBlock *block = names->blocks[b];
+		for(int i = 0; i< block->len ; i++){
+			printf("%s\t%c\t", NAME_STR(names, &(block->data)[i]), (block->data)[i].sex);
+			printf("%d",get_freq(names, &(block->data)[i], 0));
+			for(int j = 1; j< num_year; j++){
+				printf("\t%d",get_freq(names, &(block->data)[i], j));
+			}
+			printf("\n");
 		}
-		printf("\n");
 	}
 }
 
 
+// 이름 문자열은 g_pool(현재 이름 구조체의 풀)에서 찾음
+// 같은 이름은 풀에 한 번만 저장되므로 위치가 같으면 이름도 같음
 int compare( const void *n1, const void *n2){
 	tName *first = (tName *)n1;
 	tName *second = (tName *)n2;
 	
-	if(strcmp(first->name, second->name) == 0){
+	if(first->offset == second->offset){
 		if(first->sex == second->sex) return 0;
 		else if(first->sex == 'M'){
 			return 1;
@@ -195,10 +750,100 @@ int compare( const void *n1, const void *n2){
 		}
 	}
 	else{
-		return strcmp(first->name, second->name);
+		return strcmp(g_pool + first->offset, g_pool + second->offset);
 	}
 }
 
+// 문자열 해시 함수 (FNV-1a)
+unsigned int hash_str(const char *str, int len){
+	unsigned int h = 2166136261u;
+	for(int i=0; i<len; i++){
+		h = (h ^ (unsigned char)str[i]) * 16777619u;
+	}
+	return h;
+}
+
+// 이름 문자열을 풀에 저장하고 풀에서의 위치를 반환
+// 이미 저장된 문자열이면 기존 위치를 반환
+unsigned int pool_intern( tPool *pool, const char *str, int len){
+	//적재율이 1/2을 넘으면 슬롯 수를 두배로 하고 다시 채움
+	if((pool->num_keys + 1) * 2 > pool->slot_capacity){
+		unsigned int *old = pool->slot;
+		int old_capacity = pool->slot_capacity;
+		pool->slot_capacity *= 2;
+		pool->slot = (unsigned int *)calloc(pool->slot_capacity, sizeof(unsigned int));
+		
+		unsigned int mask = pool->slot_capacity - 1;
+		for(int i=0; i<old_capacity; i++){
+			if(old[i] == 0) continue;
+			const char *key = pool->data + old[i] - 1;
+			unsigned int h = hash_str(key, strlen(key)) & mask;
+			while(pool->slot[h] != 0) h = (h + 1) & mask;
+			pool->slot[h] = old[i];
+		}
+		free(old);
+	}
+	
+	unsigned int mask = pool->slot_capacity - 1;
+	unsigned int h = hash_str(str, len) & mask;
+	
+	//빈 슬롯 또는 같은 문자열을 만날 때까지 선형 탐사
+	while(pool->slot[h] != 0){
+		const char *key = pool->data + pool->slot[h] - 1;
+		if(key[len] == '\0' && !memcmp(key, str, len)) return pool->slot[h] - 1;
+		h = (h + 1) & mask;
+	}
+	
+	//풀 끝에 널 종료 문자열로 추가
+	while(pool->len + len + 1 > pool->capacity){
+		pool->data = (char *)realloc(pool->data, pool->capacity * 2);
+		pool->capacity *= 2;
+	}
+	unsigned int offset = pool->len;
+	memcpy(pool->data + offset, str, len);
+	pool->data[offset + len] = '\0';
+	pool->len += len + 1;
+	
+	pool->slot[h] = offset + 1;
+	pool->num_keys++;
+	return offset;
+}
+
+// freq 행렬의 행 수를 두배로 늘림
+// freq 행렬은 열 우선이므로 열마다 새 위치로 옮김 (새 행은 0)
+void grow_names( tNames *names){
+	int old_capacity = names->capacity;
+	names->capacity *= 2;
+	
+	if(names->num_year > 0){
+		int *freq = (int *)calloc((size_t)names->num_year * names->capacity, sizeof(int));
+		for(int j=0; j<names->num_year; j++){
+			memcpy(freq + (size_t)j * names->capacity, names->freq + (size_t)j * old_capacity, old_capacity * sizeof(int));
+		}
+		free(names->freq);
+		names->freq = freq;
+	}
+}
+
+// 연도별 빈도를 저장
+// freq 행렬에 아직 없는 연도이면 열을 추가 (새 열은 0으로 초기화)
+void set_freq( tNames *names, tName *name, int year_index, int freq){
+	if(year_index < 0 || year_index >= MAX_YEAR_DURATION) return;
+	
+	if(year_index >= names->num_year){
+		names->freq = (int *)realloc(names->freq, (size_t)(year_index + 1) * names->capacity * sizeof(int));
+		memset(names->freq + (size_t)names->num_year * names->capacity, 0, (size_t)(year_index + 1 - names->num_year) * names->capacity * sizeof(int));
+		names->num_year = year_index + 1;
+	}
+	names->freq[(size_t)year_index * names->capacity + name->row] = freq;
+}
+
+// 연도별 빈도를 반환 (저장된 적 없는 연도는 0)
+int get_freq( tNames *names, tName *name, int year_index){
+	if(year_index < 0 || year_index >= names->num_year) return 0;
+	return names->freq[(size_t)year_index * names->capacity + name->row];
+}
+
 
 
 
@@ -4,6 +4,8 @@
 #include <string.h> // strdup, strcmp
 #include <ctype.h> // toupper
 
+#include "batch.h"
+
 #define QUIT			1
 #define FORWARD_PRINT	2
 #define BACKWARD_PRINT	3
@@ -26,6 +28,7 @@ typedef struct node
 	tName		*dataPtr;
 	struct node	*llink;
 	struct node	*rlink;
+	unsigned int hash;	// hash of (name, sex) for the index
 } NODE;
 
 typedef struct
@@ -33,6 +36,8 @@ typedef struct
 	int		count;
 	NODE	*head;
 	NODE	*rear;
+	NODE	**index;		// hash index from (name, sex) to node; NULL if not indexed
+	int		index_capacity;	// number of index slots (power of 2)
 } LIST;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -44,6 +49,13 @@ typedef struct
 */
 LIST *createList(void);
 
+/* Allocates dynamic memory for a list head node with a hash index from (name, sex) to node
+	searchList and removeNode find the node in O(1); the list stays sorted for traversal
+	return	head node pointer
+			NULL if overflow
+*/
+LIST *createIndexedList(void);
+
 /* Deletes all data in list and recycles memory
 */
 void destroyList( LIST *pList);
@@ -106,6 +118,29 @@ static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, tName **dataOutPtr);
 */
 static int _search( LIST *pList, NODE **pPre, NODE **pLoc, tName *pArgu);
 
+/* internal hash function
+	return	FNV-1a hash of (name, sex)
+*/
+static unsigned int _hash( const tName *pName);
+
+/* internal index search function
+	return	address of the slot holding the node of pArgu,
+			or of the empty slot where it would be inserted
+*/
+static NODE **_indexFind( LIST *pList, const tName *pArgu, unsigned int hash);
+
+/* internal index insert function
+	adds node to the index, doubling the slots when half full
+	return	1 if successful
+			0 if memory overflow
+*/
+static int _indexInsert( LIST *pList, NODE *node);
+
+/* internal index delete function
+	removes node from the index; later slots of the probe run are shifted back
+*/
+static void _indexDelete( LIST *pList, NODE *node);
+
 ////////////////////////////////////////////////////////////////////////////////
 /* Allocates dynamic memory for a name structure, initialize fields(name, freq) and returns its address to caller
 	return	name structure pointer
@@ -184,6 +219,54 @@ void split_name_sex(char *str, char *sex)
 		*sex = *p;
 	}
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/* runs one command of run_batch (see batch.h)
+	searches and deletes use one key on the stack instead of createName
+*/
+void batch_command( void *list, char cmd, char *arg)
+{
+	tName key;
+	tName *p;
+	
+	if (arg)
+	{
+		key.sex = 0;
+		split_name_sex( arg, &key.sex); // unknown format is reported and not found
+		key.name = arg;
+		key.freq = 0;
+	}
+	
+	switch( cmd)
+	{
+		case 'P':
+			traverseList( (LIST *)list, print_name);
+			break;
+		
+		case 'B':
+			traverseListR( (LIST *)list, print_name);
+			break;
+		
+		case 'S':
+			if (searchList( (LIST *)list, &key, &p)) print_name( p);
+			else fprintf( stdout, "%s not found\n", arg);
+			break;
+		
+		case 'D':
+			if (removeNode( (LIST *)list, &key, &p))
+			{
+				fprintf( stdout, "(%s, %c, %d) deleted\n", p->name, p->sex, p->freq);
+				destroyName( p);
+			}
+			else fprintf( stdout, "%s not found\n", arg);
+			break;
+		
+		case 'C':
+			fprintf( stdout, "%d\n", countList( (LIST *)list));
+			break;
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 int main( int argc, char **argv)
 {
@@ -197,9 +280,24 @@ int main( int argc, char **argv)
 	tName *pName;
 	int ret;
 	FILE *fp;
+	FILE *script = NULL;
+	
+	// batch mode
+	if (argc == 4 && strcmp( argv[1], "--batch") == 0)
+	{
+		script = fopen( argv[2], "rt");
+		if (!script)
+		{
+			fprintf( stderr, "Error: cannot open file [%s]\n", argv[2]);
+			return 2;
+		}
+		argv[2] = argv[0];
+		argv += 2;
+		argc -= 2;
+	}
 	
 	if (argc != 2){
-		fprintf( stderr, "usage: %s FILE\n", argv[0]);
+		fprintf( stderr, "usage: %s [--batch SCRIPT] FILE\n", argv[0]);
 		return 1;
 	}
 	
@@ -211,7 +309,7 @@ int main( int argc, char **argv)
 	}
 	
 	// creates an empty list
-	list = createList();
+	list = createIndexedList();
 	if (!list)
 	{
 		printf( "Cannot create list\n");
@@ -232,6 +330,14 @@ int main( int argc, char **argv)
 	
 	fclose( fp);
 	
+	if (script)
+	{
+		run_batch( list, script, batch_command);
+		fclose( script);
+		destroyList( list);
+		return 0;
+	}
+	
 	fprintf( stderr, "Select Q)uit, P)rint, B)ackward print, S)earch, D)elete, C)ount: ");
 	
 	while (1)
@@ -302,6 +408,25 @@ LIST *createList(void){
 	ptr->count = 0;
 	ptr->head = NULL;
 	ptr->rear = NULL;
+	ptr->index = NULL;
+	ptr->index_capacity = 0;
+	return ptr;
+}
+
+/* Allocates dynamic memory for a list head node with a hash index from (name, sex) to node
+	searchList and removeNode find the node in O(1); the list stays sorted for traversal
+	return	head node pointer
+			NULL if overflow
+*/
+LIST *createIndexedList(void){
+	LIST *ptr = createList();
+	if(ptr == NULL) return NULL;
+	ptr->index_capacity = 1024;
+	ptr->index = (NODE **)calloc(ptr->index_capacity, sizeof(NODE *));
+	if(ptr->index == NULL){
+		free(ptr);
+		return NULL;
+	}
 	return ptr;
 }
 
@@ -316,6 +441,7 @@ void destroyList( LIST *pList){
 		free(curNode);
 		curNode = temp;
 	}
+	free(pList->index);
 	free(pList);
 }
 
@@ -325,6 +451,15 @@ void destroyList( LIST *pList){
 			2 if duplicated key
 */
 int addNode( LIST *pList, tName *dataInPtr){
+	//인덱스가 있으면 중복 키를 O(1)에 확인
+	if(pList->index != NULL){
+		NODE *node = *_indexFind(pList, dataInPtr, _hash(dataInPtr));
+		if(node != NULL){
+			increase_freq(node->dataPtr, dataInPtr);
+			return 2;
+		}
+	}
+	
 	NODE *curNode = pList->head;
 	if(curNode == NULL) return _insert(pList,NULL,dataInPtr);
 	while(curNode != NULL){
@@ -413,6 +548,10 @@ static int _insert( LIST *pList, NODE *pPre, tName *dataInPtr){
 	NODE *node;
 	if(node = (NODE *)malloc(sizeof(NODE))){
 		node->dataPtr = dataInPtr;
+		if(pList->index != NULL && !_indexInsert(pList, node)){
+			free(node);
+			return 0;
+		}
 		//널리스트에 삽입
 		if(emptyList(pList) == 1){
 			node->llink = node->rlink = NULL;
@@ -451,6 +590,7 @@ static int _insert( LIST *pList, NODE *pPre, tName *dataInPtr){
 */
 static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, tName **dataOutPtr){
 	*dataOutPtr = pLoc->dataPtr;
+	if(pList->index != NULL) _indexDelete(pList, pLoc);
 	if(pLoc == pList->head){
 		if(pLoc == pList->rear){
 			pList->head = NULL;
@@ -479,6 +619,15 @@ static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, tName **dataOutPtr){
 			0 not found
 */
 static int _search( LIST *pList, NODE **pPre, NODE **pLoc, tName *pArgu){
+	//인덱스가 있으면 O(1) 탐색
+	if(pList->index != NULL){
+		NODE *node = *_indexFind(pList, pArgu, _hash(pArgu));
+		if(node == NULL) return 0;
+		*pPre = node->llink;
+		*pLoc = node;
+		return 1;
+	}
+	
 	NODE *curNode = pList->head;
 	while(curNode != NULL){
 		if(cmpName(curNode->dataPtr,pArgu) == 0){ 
@@ -491,6 +640,85 @@ static int _search( LIST *pList, NODE **pPre, NODE **pLoc, tName *pArgu){
 	return 0;
 }
 
+/* internal hash function
+	return	FNV-1a hash of (name, sex)
+*/
+static unsigned int _hash( const tName *pName){
+	unsigned int h = 2166136261u;
+	for(const char *p = pName->name; *p; p++){
+		h = (h ^ (unsigned char)*p) * 16777619u;
+	}
+	return (h ^ (unsigned char)pName->sex) * 16777619u;
+}
+
+/* internal index search function
+	return	address of the slot holding the node of pArgu,
+			or of the empty slot where it would be inserted
+*/
+static NODE **_indexFind( LIST *pList, const tName *pArgu, unsigned int hash){
+	unsigned int mask = pList->index_capacity - 1;
+	unsigned int h = hash & mask;
+	
+	//빈 슬롯 또는 같은 키를 만날 때까지 선형 탐사
+	while(pList->index[h] != NULL){
+		NODE *node = pList->index[h];
+		if(node->hash == hash && cmpName(node->dataPtr, pArgu) == 0) break;
+		h = (h + 1) & mask;
+	}
+	return &pList->index[h];
+}
+
+/* internal index insert function
+	adds node to the index, doubling the slots when half full
+	return	1 if successful
+			0 if memory overflow
+*/
+static int _indexInsert( LIST *pList, NODE *node){
+	//슬롯의 절반이 차면 두배로 늘리고 저장된 해시로 다시 채움
+	if((pList->count + 1) * 2 > pList->index_capacity){
+		int capacity = pList->index_capacity * 2;
+		NODE **index = (NODE **)calloc(capacity, sizeof(NODE *));
+		if(index == NULL) return 0;
+		
+		for(int i=0; i<pList->index_capacity; i++){
+			NODE *old = pList->index[i];
+			if(old == NULL) continue;
+			unsigned int h = old->hash & (capacity - 1);
+			while(index[h] != NULL) h = (h + 1) & (capacity - 1);
+			index[h] = old;
+		}
+		free(pList->index);
+		pList->index = index;
+		pList->index_capacity = capacity;
+	}
+	
+	node->hash = _hash(node->dataPtr);
+	*_indexFind(pList, node->dataPtr, node->hash) = node;
+	return 1;
+}
+
+/* internal index delete function
+	removes node from the index; later slots of the probe run are shifted back
+*/
+static void _indexDelete( LIST *pList, NODE *node){
+	unsigned int mask = pList->index_capacity - 1;
+	unsigned int hole = _indexFind(pList, node->dataPtr, node->hash) - pList->index;
+	unsigned int h = hole;
+	
+	//구멍 뒤의 노드 중 원래 자리가 구멍 이전인 노드를 구멍으로 옮김
+	while(1){
+		h = (h + 1) & mask;
+		NODE *next = pList->index[h];
+		if(next == NULL) break;
+		unsigned int home = next->hash & mask;
+		if(((h - home) & mask) >= ((h - hole) & mask)){
+			pList->index[hole] = next;
+			hole = h;
+		}
+	}
+	pList->index[hole] = NULL;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /* Allocates dynamic memory for a name structure, initialize fields(name, freq) and returns its address to caller
 	return	name structure pointer
@@ -1,6 +1,190 @@
 #include <stdlib.h> // malloc
+#include <string.h> // memcpy
+#include <sched.h> // sched_yield
 
 #include "adt_dlist.h"
+#include "adt_dlist_internal.h"
+
+// links that concurrent readers follow are stored with release and loaded with acquire
+#define PUBLISH(lval, val)	__atomic_store_n(&(lval), (val), __ATOMIC_RELEASE)
+#define READ(lval)			__atomic_load_n(&(lval), __ATOMIC_ACQUIRE)
+
+/* internal node allocation function
+	takes a node from the free list or the current slab if the list has LIST_NODE_POOL
+	return	node pointer
+			NULL if memory overflow
+*/
+static NODE *_allocNode( LIST *pList){
+	if(!(pList->flags & LIST_NODE_POOL)) return (NODE *)malloc(sizeof(NODE));
+	
+	if(pList->freeNode != NULL){
+		NODE *node = pList->freeNode;
+		pList->freeNode = node->rlink;
+		return node;
+	}
+	if(pList->slabNode == pList->slabEnd){
+		//슬랩의 첫 노드 자리는 슬랩 리스트 연결에 사용
+		NODE *slab = (NODE *)malloc(sizeof(NODE) * (SLAB_SIZE + 1));
+		if(slab == NULL) return NULL;
+		*(void **)slab = pList->slabs;
+		pList->slabs = slab;
+		pList->slabNode = slab + 1;
+		pList->slabEnd = slab + SLAB_SIZE + 1;
+	}
+	return pList->slabNode++;
+}
+
+/* internal node recycling function
+*/
+static void _freeNode( LIST *pList, NODE *node){
+	if(!(pList->flags & LIST_NODE_POOL)){
+		free(node);
+		return;
+	}
+	node->rlink = pList->freeNode;
+	pList->freeNode = node;
+}
+
+/* internal key function
+	return	key prefix of data (0 if the list has no keyOf)
+*/
+static inline unsigned long long _keyOf( LIST *pList, const void *dataPtr){
+	return (pList->keyOf != NULL) ? pList->keyOf(dataPtr) : 0;
+}
+
+/* internal compare function
+	compares the data of node with pArgu whose key prefix is key
+	the prefix cached in node decides most comparisons without calling compare
+*/
+static inline int _compareNode( LIST *pList, NODE *node, unsigned long long key, const void *pArgu){
+	if(pList->keyOf != NULL){
+		if(node->key != key) return (node->key < key) ? -1 : 1;
+		if(pList->flags & LIST_EXACT_KEY) return 0;
+	}
+	return pList->compare(node->dataPtr, pArgu);
+}
+
+/* internal skip list search function
+	finds the first node whose key is not less than pArgu using the express lane
+	key is the key prefix of pArgu
+	update[i] receives the last node before it at level i+1 (NULL means skipHead)
+	return	the node found
+			NULL if all keys are less than pArgu
+*/
+static NODE *_searchSkip( LIST *pList, void *pArgu, unsigned long long key, NODE **update){
+	NODE *pPre = NULL;
+	for(int i=READ(pList->level)-2; i>=0; i--){
+		NODE *next = (pPre == NULL) ? READ(pList->skipHead[i]) : READ(pPre->skip[i]);
+		while(next != NULL && _compareNode(pList, next, key, pArgu) < 0){
+			pPre = next;
+			next = READ(pPre->skip[i]);
+		}
+		if(update) update[i] = pPre;
+	}
+	
+	//llink/rlink 체인에서 마지막 구간을 찾음
+	NODE *curNode = (pPre == NULL) ? READ(pList->head) : READ(pPre->rlink);
+	while(curNode != NULL && _compareNode(pList, curNode, key, pArgu) < 0){
+		curNode = READ(curNode->rlink);
+	}
+	return curNode;
+}
+
+/* internal function
+	builds a random tower for a node already linked into the llink/rlink chain
+	return	1 if successful
+			0 if memory overflow
+*/
+static int _linkTower( LIST *pList, NODE *node){
+	node->level = 1;
+	node->skip = NULL;
+	if(pList->level == 0) return 1;
+	
+	//높이 h인 탑은 확률 1/4로 h+1이 됨
+	int level = 1;
+	while(level < SKIP_MAX_LEVEL){
+		pList->seed ^= pList->seed << 13;
+		pList->seed ^= pList->seed >> 17;
+		pList->seed ^= pList->seed << 5;
+		if(pList->seed & 3) break;
+		level++;
+	}
+	if(level == 1) return 1;
+	
+	if(pList->flags & LIST_NODE_POOL) node->skip = (NODE **)_arenaAlloc(pList, sizeof(NODE *) * (level-1));
+	else node->skip = (NODE **)malloc(sizeof(NODE *) * (level-1));
+	if(node->skip == NULL) return 0;
+	node->level = level;
+	
+	NODE *update[SKIP_MAX_LEVEL];
+	_searchSkip(pList, node->dataPtr, node->key, update);
+	
+	for(int i=0; i<level-1; i++){
+		//새로 높아진 레벨
+		if(i >= pList->level - 1) update[i] = NULL;
+		NODE **next = (update[i] == NULL) ? &pList->skipHead[i] : &update[i]->skip[i];
+		node->skip[i] = *next;
+		PUBLISH(*next, node);
+	}
+	if(level > pList->level) PUBLISH(pList->level, level);
+	return 1;
+}
+
+/* internal function
+	removes the tower of a node from the express lane
+	the tower itself is freed later by _freeTower
+*/
+static void _unlinkTower( LIST *pList, NODE *node){
+	if(node->level == 1) return;
+	
+	NODE *update[SKIP_MAX_LEVEL];
+	_searchSkip(pList, node->dataPtr, node->key, update);
+	
+	for(int i=0; i<node->level-1; i++){
+		NODE **next = (update[i] == NULL) ? &pList->skipHead[i] : &update[i]->skip[i];
+		PUBLISH(*next, node->skip[i]);
+	}
+	
+	//비어 있는 최상위 레벨을 줄임
+	while(pList->level > 1 && pList->skipHead[pList->level-2] == NULL) PUBLISH(pList->level, pList->level-1);
+}
+
+/* internal function
+	frees the tower of a node unlinked by _unlinkTower
+*/
+static void _freeTower( LIST *pList, NODE *node){
+	if(node->level == 1) return;
+	if(pList->flags & LIST_NODE_POOL) _arenaFree(pList, node->skip, sizeof(NODE *) * (node->level-1));
+	else free(node->skip);
+	node->skip = NULL;
+}
+
+/* internal function
+	waits for a grace period of a LIST_CONCURRENT list:
+	every reader that entered before the call has left, so nodes
+	unlinked before the call can no longer be seen by any reader
+*/
+static void _synchronize( LIST *pList){
+	unsigned long epoch = __atomic_add_fetch(&pList->epoch, 1, __ATOMIC_SEQ_CST);
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+	for(int i=0; i<LIST_MAX_READERS; i++){
+		unsigned long *slot = &pList->readers[i * READER_STRIDE];
+		unsigned long e;
+		//새 epoch 이전에 들어온 reader만 기다림
+		while((e = __atomic_load_n(slot, __ATOMIC_ACQUIRE)) != 0 && e < epoch) sched_yield();
+	}
+}
+
+/* internal writer lock function
+	serializes writers of a LIST_CONCURRENT list
+*/
+static void _writeLock( LIST *pList){
+	if(pList->flags & LIST_CONCURRENT) pthread_mutex_lock(&pList->writeLock);
+}
+
+static void _writeUnlock( LIST *pList){
+	if(pList->flags & LIST_CONCURRENT) pthread_mutex_unlock(&pList->writeLock);
+}
 
 /* internal insert function
 	inserts data into a new node
@@ -9,36 +193,41 @@
 */
 static int _insert( LIST *pList, NODE *pPre, void *dataInPtr){
 	NODE *node;
-	if(node = (NODE *)malloc(sizeof(NODE))){
+	if(node = _allocNode(pList)){
 		node->dataPtr = dataInPtr;
+		node->key = _keyOf(pList, dataInPtr);
+		//노드의 링크를 모두 채운 뒤에 리스트에 공개함
 		//널리스트에 삽입
 		if(emptyList(pList) == 1){
 			node->llink = node->rlink = NULL;
-			pList->head = node;
-			pList->rear = node;
+			PUBLISH(pList->head, node);
+			PUBLISH(pList->rear, node);
 		}
 		//리스트의 제일 앞에 삽입
 		else if(pPre == NULL){
 			node->llink = NULL;
 			node->rlink = pList->head;
-			pList->head->llink = node;
-			pList->head = node;
+			PUBLISH(pList->head->llink, node);
+			PUBLISH(pList->head, node);
 		}
 		//리스트 끝에 삽입
 		else if(pPre == pList->rear){
 			node->rlink = NULL;
 			node->llink = pList->rear;
-			pList->rear->rlink = node;
-			pList->rear = node;
+			PUBLISH(pList->rear->rlink, node);
+			PUBLISH(pList->rear, node);
 		}
 		//리스트 중간에 삽입
 		else{
 			node->rlink = pPre->rlink;
-			pPre->rlink->llink = node;
-			pPre->rlink = node;
 			node->llink = pPre;
+			PUBLISH(pPre->rlink->llink, node);
+			PUBLISH(pPre->rlink, node);
 		}
-		pList->count += 1;
+		PUBLISH(pList->count, pList->count + 1);
+		
+		//express lane이 있으면 탑을 만듦
+		_linkTower(pList, node);
 		return 1;
 	}
 	return 0;
@@ -46,28 +235,34 @@ static int _insert( LIST *pList, NODE *pPre, void *dataInPtr){
 
 /* internal delete function
 	deletes data from a list and saves the (deleted) data to dataOut
+	the links of pLoc are left intact, so a concurrent reader standing on it can move on;
+	pLoc is freed after a grace period in LIST_CONCURRENT mode
 */
 static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, void **dataOutPtr){
 	*dataOutPtr = pLoc->dataPtr;
+	_unlinkTower(pList, pLoc);
 	if(pLoc == pList->head){
 		if(pLoc == pList->rear){
-			pList->head = NULL;
-			pList->rear = NULL;
+			PUBLISH(pList->head, NULL);
+			PUBLISH(pList->rear, NULL);
 		}
 		else{
-			pList->head = pLoc->rlink;
-			pList->head->llink = pPre;
+			PUBLISH(pList->head, pLoc->rlink);
+			PUBLISH(pList->head->llink, pPre);
 		}
 	}
 	else if(pLoc == pList->rear){
-		pList->rear = pPre;
-		pList->rear->rlink = NULL;
+		PUBLISH(pList->rear, pPre);
+		PUBLISH(pList->rear->rlink, NULL);
 	}
 	else{
-		pPre->rlink = pLoc->rlink;
-		pLoc->rlink->llink = pPre;
+		PUBLISH(pPre->rlink, pLoc->rlink);
+		PUBLISH(pLoc->rlink->llink, pPre);
 	}
-	free(pLoc);
+	
+	if(pList->flags & LIST_CONCURRENT) _synchronize(pList);
+	_freeTower(pList, pLoc);
+	_freeNode(pList, pLoc);
 }
 
 /* internal search function
@@ -77,14 +272,25 @@ static void _delete( LIST *pList, NODE *pPre, NODE *pLoc, void **dataOutPtr){
 			0 not found
 */
 static int _search( LIST *pList, NODE **pPre, NODE **pLoc, void *pArgu){
-	NODE *curNode = pList->head;
+	unsigned long long key = _keyOf(pList, pArgu);
+	
+	//express lane이 있으면 O(log N) 탐색
+	if(READ(pList->level) > 0){
+		NODE *node = _searchSkip(pList, pArgu, key, NULL);
+		if(node == NULL || _compareNode(pList, node, key, pArgu) != 0) return 0;
+		*pPre = READ(node->llink);
+		*pLoc = node;
+		return 1;
+	}
+	
+	NODE *curNode = READ(pList->head);
 	while(curNode != NULL){
-		if(pList->compare(curNode->dataPtr,pArgu) == 0){ 
-			*pPre = curNode->llink;
+		if(_compareNode(pList, curNode, key, pArgu) == 0){
+			*pPre = READ(curNode->llink);
 			*pLoc = curNode;
 			return 1;
 		}
-		curNode = curNode->rlink;
+		curNode = READ(curNode->rlink);
 	}
 	return 0;
 }
@@ -94,41 +300,172 @@ static int _search( LIST *pList, NODE **pPre, NODE **pLoc, void *pArgu){
 			NULL if overflow
 */
 LIST *createList( int (*compare)(const void *, const void *)){
+	return createListEx(compare, 0);
+}
+
+/* Allocates dynamic memory for a list head node with LIST_* options
+	LIST_SKIP		adds the skip list express lane (see createSkipList)
+	LIST_NODE_POOL	allocates nodes from slabs with a free list instead of one malloc per node
+	LIST_DATA_ARENA	makes allocData/freeData use an arena owned by the list;
+					destroyList releases all payloads at once (callback may be NULL)
+	LIST_CONCURRENT	lets searchList/traverseList run in many threads while writers
+					(addNode, addNodesBulk, removeNode) are serialized by a lock
+	return	head node pointer
+			NULL if overflow
+*/
+LIST *createListEx( int (*compare)(const void *, const void *), int flags){
+	return createListKey(compare, NULL, flags);
+}
+
+/* Allocates dynamic memory for a list head node with a cached key prefix
+	keyOf returns an order-preserving 64-bit prefix of data:
+	keyOf(a) < keyOf(b) must imply compare(a, b) < 0
+	each node caches the prefix, so compare is called only when prefixes are equal
+	(never with LIST_EXACT_KEY, where equal prefixes mean equal keys)
+	return	head node pointer
+			NULL if overflow
+*/
+LIST *createListKey( int (*compare)(const void *, const void *), unsigned long long (*keyOf)(const void *), int flags){
 	LIST *ptr = (LIST *)malloc(sizeof(LIST));
+	if(ptr == NULL) return NULL;
 	ptr->count = 0;
 	ptr->head = NULL;
 	ptr->rear = NULL;
 	ptr->compare = compare;
+	ptr->keyOf = keyOf;
+	ptr->level = (flags & LIST_SKIP) ? 1 : 0;
+	ptr->seed = 2463534242u;
+	for(int i=0; i<SKIP_MAX_LEVEL; i++) ptr->skipHead[i] = NULL;
+	ptr->flags = flags;
+	ptr->freeNode = NULL;
+	ptr->slabNode = ptr->slabEnd = NULL;
+	ptr->slabs = NULL;
+	ptr->arenaPtr = ptr->arenaEnd = NULL;
+	ptr->chunks = NULL;
+	for(int i=0; i<ARENA_CLASSES; i++) ptr->freeBlock[i] = NULL;
+	if(flags & LIST_CONCURRENT) pthread_mutex_init(&ptr->writeLock, NULL);
+	ptr->epoch = 1;
+	for(int i=0; i<LIST_MAX_READERS * READER_STRIDE; i++) ptr->readers[i] = 0;
 	return ptr;
 }
 
+/* Allocates dynamic memory for a list head node with a skip list express lane
+	nodes get probabilistic towers over the llink/rlink chain,
+	so search, insert and delete take O(log N) expected time
+	return	head node pointer
+			NULL if overflow
+*/
+LIST *createSkipList( int (*compare)(const void *, const void *)){
+	return createListEx(compare, LIST_SKIP);
+}
+
 /* Deletes all data in list and recycles memory
+	callback is called for each data unless it is NULL
+	node slabs and the payload arena are released at once
 */
 void destroyList( LIST *pList, void (*callback)(void *)){
 	NODE *curNode = pList->head;
-	for(int i=0; i<pList->count; i++){
-		NODE *temp = curNode->rlink;
-		callback(curNode->dataPtr);
-		free(curNode);
-		curNode = temp;
+	//풀을 쓰지 않는 노드만 하나씩 해제
+	if(callback != NULL || !(pList->flags & LIST_NODE_POOL)){
+		for(int i=0; i<pList->count; i++){
+			NODE *temp = curNode->rlink;
+			if(callback != NULL) callback(curNode->dataPtr);
+			if(!(pList->flags & LIST_NODE_POOL)){
+				free(curNode->skip);
+				free(curNode);
+			}
+			curNode = temp;
+		}
 	}
+	
+	//슬랩과 청크를 통째로 해제
+	while(pList->slabs != NULL){
+		void *next = *(void **)pList->slabs;
+		free(pList->slabs);
+		pList->slabs = next;
+	}
+	while(pList->chunks != NULL){
+		void *next = *(void **)pList->chunks;
+		free(pList->chunks);
+		pList->chunks = next;
+	}
+	if(pList->flags & LIST_CONCURRENT) pthread_mutex_destroy(&pList->writeLock);
 	free(pList);
 }
 
-/* Inserts data into list
-	return	0 if overflow
-			1 if successful
-			2 if duplicated key
+/* Enters a read-side critical section of a LIST_CONCURRENT list
+	nodes and data seen inside are not freed by removeNode until readUnlockList,
+	so data returned by searchList stays valid until then
+	must not be held by a thread calling addNode, addNodesBulk or removeNode
+	return	slot number to pass to readUnlockList
+			-1 if the list is not concurrent
 */
-int addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *, const void *)){
+int readLockList( LIST *pList){
+	if(!(pList->flags & LIST_CONCURRENT)) return -1;
+	while(1){
+		for(int i=0; i<LIST_MAX_READERS; i++){
+			unsigned long *slot = &pList->readers[i * READER_STRIDE];
+			unsigned long empty = 0;
+			unsigned long epoch = __atomic_load_n(&pList->epoch, __ATOMIC_SEQ_CST);
+			if(__atomic_compare_exchange_n(slot, &empty, epoch, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)){
+				//슬롯 기록이 이후의 링크 읽기보다 먼저 보이도록 함
+				__atomic_thread_fence(__ATOMIC_SEQ_CST);
+				return i;
+			}
+		}
+		sched_yield();
+	}
+}
+
+/* Leaves a read-side critical section entered by readLockList
+*/
+void readUnlockList( LIST *pList, int slot){
+	if(slot < 0) return;
+	__atomic_store_n(&pList->readers[slot * READER_STRIDE], 0, __ATOMIC_RELEASE);
+}
+
+/* Allocates memory for a payload
+	from the list arena if the list has LIST_DATA_ARENA, otherwise by malloc
+	return	pointer to size bytes (8-byte aligned)
+			NULL if overflow
+*/
+void *allocData( LIST *pList, size_t size){
+	if(pList->flags & LIST_DATA_ARENA) return _arenaAlloc(pList, size);
+	return malloc(size);
+}
+
+/* Recycles memory returned by allocData
+	size must be the size given to allocData
+*/
+void freeData( LIST *pList, void *dataPtr, size_t size){
+	if(pList->flags & LIST_DATA_ARENA) _arenaFree(pList, dataPtr, size);
+	else free(dataPtr);
+}
+
+/* internal function of addNode (called with the writer lock held)
+*/
+static int _addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *, const void *)){
+	unsigned long long key = _keyOf(pList, dataInPtr);
+	
+	//express lane이 있으면 삽입 위치를 O(log N)에 찾음
+	if(pList->level > 0){
+		NODE *node = _searchSkip(pList, dataInPtr, key, NULL);
+		if(node != NULL && _compareNode(pList, node, key, dataInPtr) == 0){
+			callback(node->dataPtr, dataInPtr);
+			return 2;
+		}
+		return _insert(pList, (node == NULL) ? pList->rear : node->llink, dataInPtr);
+	}
+	
 	NODE *curNode = pList->head;
 	if(curNode == NULL) return _insert(pList,NULL,dataInPtr);
 	while(curNode != NULL){
-		if(pList->compare(curNode->dataPtr, dataInPtr) == 0) {
+		int ret = _compareNode(pList, curNode, key, dataInPtr);
+		if(ret == 0) {
 			callback(curNode->dataPtr,dataInPtr);
 			return 2;
 		}
-		else if(pList->compare(curNode->dataPtr, dataInPtr) > 0){
+		else if(ret > 0){
 			return _insert(pList,curNode->llink,dataInPtr);
 		}
 		curNode = curNode->rlink;
@@ -136,22 +473,104 @@ int addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *, const
 	return _insert(pList,pList->rear,dataInPtr);
 }
 
+/* Inserts data into list
+	return	0 if overflow
+			1 if successful
+			2 if duplicated key
+*/
+int addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *, const void *)){
+	_writeLock(pList);
+	int ret = _addNode(pList, dataInPtr, callback);
+	_writeUnlock(pList);
+	return ret;
+}
+
+/* internal merge function of addNodesBulk (called with the writer lock held)
+	merges sorted dataInPtrs into the list in one pass
+	return	number of inserted nodes
+			-1 if overflow
+*/
+static int _mergeData( LIST *pList, void **dataInPtrs, int count, void (*callback)(const void *, const void *)){
+	NODE *pPre = NULL;			// 삽입 위치의 앞 노드
+	NODE *curNode = pList->head;	// 삽입 위치의 뒤 노드
+	NODE *last = NULL;			// 직전 데이터와 같은 키를 가진 노드
+	int inserted = 0;
+	
+	for(int i=0; i<count; i++){
+		void *dataInPtr = dataInPtrs[i];
+		unsigned long long key = _keyOf(pList, dataInPtr);
+		
+		//배치 안에서 직전 데이터와 같은 키
+		if(last != NULL && _compareNode(pList, last, key, dataInPtr) == 0){
+			callback(last->dataPtr, dataInPtr);
+			continue;
+		}
+		
+		//리스트에서 dataInPtr보다 작지 않은 첫 노드까지 이동
+		int ret = 1;
+		while(curNode != NULL && (ret = _compareNode(pList, curNode, key, dataInPtr)) < 0){
+			pPre = curNode;
+			curNode = curNode->rlink;
+		}
+		
+		//리스트에 이미 키가 존재할 때
+		if(curNode != NULL && ret == 0){
+			callback(curNode->dataPtr, dataInPtr);
+			last = curNode;
+			continue;
+		}
+		
+		if(!_insert(pList, pPre, dataInPtr)) return -1;
+		pPre = (pPre == NULL) ? pList->head : pPre->rlink;
+		last = pPre;
+		dataInPtrs[i] = NULL;
+		inserted++;
+	}
+	return inserted;
+}
+
+/* Inserts a batch of data into list
+	sorts dataInPtrs once (stable, by pList->compare) and merges it into the list in one pass
+	duplicated keys (with the list or within the batch) are passed to callback like addNode
+	on return, entries inserted into the list are set to NULL;
+	the remaining (duplicated) entries still belong to the caller
+	return	number of inserted nodes
+			-1 if overflow
+*/
+int addNodesBulk( LIST *pList, void **dataInPtrs, int count, void (*callback)(const void *, const void *)){
+	if(!_sortData(pList, dataInPtrs, count)) return -1;
+	
+	_writeLock(pList);
+	int inserted = _mergeData(pList, dataInPtrs, count, callback);
+	_writeUnlock(pList);
+	return inserted;
+}
+
 /* Removes data from list
+	in LIST_CONCURRENT mode, waits until no reader can see the node,
+	so the removed data may be freed as soon as this returns
 	return	0 not found
 			1 deleted
 */
 int removeNode( LIST *pList, void *keyPtr, void **dataOutPtr){
 	NODE *pPre;
 	NODE *pLoc;
-	if(_search(pList, &pPre, &pLoc, keyPtr) == 0) return 0;
+	_writeLock(pList);
+	if(_search(pList, &pPre, &pLoc, keyPtr) == 0){
+		_writeUnlock(pList);
+		return 0;
+	}
 	else{
 		_delete(pList,pPre,pLoc,dataOutPtr);
-		pList->count--;
+		PUBLISH(pList->count, pList->count - 1);
+		_writeUnlock(pList);
 		return 1;
 	}
 }
 
 /* interface to search function
+	safe to call from many threads of a LIST_CONCURRENT list;
+	hold readLockList to keep using dataOut after it returns
 	Argu	key being sought
 	dataOut	contains found data
 	return	1 successful
@@ -160,43 +579,49 @@ int removeNode( LIST *pList, void *keyPtr, void **dataOutPtr){
 int searchList( LIST *pList, void *pArgu, void **dataOutPtr){
 	NODE *pPre;
 	NODE *pLoc;
+	int slot = readLockList(pList);
 	int temp = _search(pList,&pPre,&pLoc,pArgu);
-	if(temp == 0) return 0;
-	else{
-		*dataOutPtr = pLoc->dataPtr;
-		return 1;
-	}
+	//노드는 읽기 구간 안에서만 읽음 (해제 후에는 removeNode가 노드를 해제할 수 있음)
+	if(temp != 0) *dataOutPtr = pLoc->dataPtr;
+	readUnlockList(pList, slot);
+	return temp;
 }
 
 /* returns number of nodes in list
 */
 int countList( LIST *pList){
-	return pList->count;
+	return READ(pList->count);
 }
 
 /* returns	1 empty
 			0 list has data
 */
 int emptyList( LIST *pList){
-	return pList->count == 0 ? 1 : 0;
+	return READ(pList->count) == 0 ? 1 : 0;
 }
 
 /* traverses data from list (forward)
+	safe to call from many threads of a LIST_CONCURRENT list
 */
 void traverseList( LIST *pList, void (*callback)(const void *)){
-	NODE *curNode = pList->head;
-	for(int i=0; i<pList->count;i++){
+	int slot = readLockList(pList);
+	NODE *curNode = READ(pList->head);
+	while(curNode != NULL){
 		callback(curNode->dataPtr);
-		curNode = curNode->rlink;
+		curNode = READ(curNode->rlink);
 	}
+	readUnlockList(pList, slot);
 }
 
 /* traverses data from list (backward)
+	safe to call from many threads of a LIST_CONCURRENT list
 */
 void traverseListR( LIST *pList, void (*callback)(const void *)){
-	NODE *curNode = pList->rear;
-	for(int i=0; i<pList->count;i++){
+	int slot = readLockList(pList);
+	NODE *curNode = READ(pList->rear);
+	while(curNode != NULL){
 		callback(curNode->dataPtr);
-		curNode = curNode->llink;
+		curNode = READ(curNode->llink);
 	}
+	readUnlockList(pList, slot);
 }
\ No newline at end of file
@@ -1,4 +1,51 @@
+#include <stddef.h> // size_t
+#include <pthread.h> // pthread_mutex_t
+
+#define SKIP_MAX_LEVEL	16 // maximum tower height of skip list (express lane)
+
+// options for createListEx
+#define LIST_SKIP		1 // skip list express lane
+#define LIST_NODE_POOL	2 // nodes (and towers) come from slabs released at once by destroyList
+#define LIST_DATA_ARENA	4 // allocData returns memory from an arena owned by the list
+#define LIST_EXACT_KEY	8 // equal keyOf prefixes mean equal keys (compare is never called)
+#define LIST_CONCURRENT	16 // readers run lock-free beside one serialized writer (see readLockList)
+
+#define SLAB_SIZE		1024		// nodes per slab
+#define ARENA_CHUNK		(1 << 20)	// bytes per arena chunk
+#define ARENA_CLASSES	64			// size classes (8 bytes apart) recycled by freeData
+
+#define LIST_MAX_READERS	64	// concurrent read-side sections of a LIST_CONCURRENT list
+#define READER_STRIDE		8	// reader slots are one cache line (8 words) apart
+
+#ifdef UNROLLED_LIST
+#define UNROLL_SIZE		32 // data pointers per node of the unrolled list
 
+////////////////////////////////////////////////////////////////////////////////
+// LIST type definition (unrolled list, adt_udlist.c)
+typedef struct node
+{
+	int			n;					// number of data in this node
+	void		*data[UNROLL_SIZE];	// data pointers sorted by compare
+	struct node	*llink;
+	struct node	*rlink;
+} NODE;
+
+typedef struct
+{
+	int		count;		// number of data (not nodes)
+	NODE	*head;
+	NODE	*rear;
+	int		(*compare)(const void *, const void *);
+	unsigned long long (*keyOf)(const void *); // not cached by the unrolled list
+	int		flags;		// LIST_* options given at creation (LIST_SKIP is ignored)
+	NODE	*freeNode;	// recycled pool nodes (linked by rlink)
+	char	*arenaPtr;	// next free byte in the current arena chunk
+	char	*arenaEnd;	// end of the current arena chunk
+	void	*chunks;	// arena chunks (linked through their first word)
+	void	*freeBlock[ARENA_CLASSES]; // recycled arena blocks per size class
+} LIST;
+
+#else
 ////////////////////////////////////////////////////////////////////////////////
 // LIST type definition
 typedef struct node
@@ -6,6 +53,9 @@ typedef struct node
 	void		*dataPtr;
 	struct node	*llink;
 	struct node	*rlink;
+	int			level;	// tower height (1 if the node is only in the llink/rlink chain)
+	struct node	**skip;	// skip[i] is the next node at level i+1; NULL if level is 1
+	unsigned long long key;	// cached key prefix of dataPtr (see createListKey)
 } NODE;
 
 typedef struct
@@ -14,7 +64,53 @@ typedef struct
 	NODE	*head;
 	NODE	*rear;
 	int		(*compare)(const void *, const void *); // used in _search function
+	unsigned long long (*keyOf)(const void *); // key prefix of data; NULL if not cached
+	int		level;		// current skip list height; 0 if the list has no express lane
+	NODE	*skipHead[SKIP_MAX_LEVEL]; // skipHead[i] is the first node at level i+1
+	unsigned int seed;	// random state for tower heights
+	int		flags;		// LIST_* options given at creation
+	NODE	*freeNode;	// recycled pool nodes (linked by rlink)
+	NODE	*slabNode;	// next unused node in the current slab
+	NODE	*slabEnd;	// end of the current slab
+	void	*slabs;		// node slabs (linked through their first word)
+	char	*arenaPtr;	// next free byte in the current arena chunk
+	char	*arenaEnd;	// end of the current arena chunk
+	void	*chunks;	// arena chunks (linked through their first word)
+	void	*freeBlock[ARENA_CLASSES]; // recycled arena blocks per size class
+	pthread_mutex_t writeLock;	// serializes writers (LIST_CONCURRENT)
+	unsigned long epoch;		// grace period counter (LIST_CONCURRENT)
+	unsigned long readers[LIST_MAX_READERS * READER_STRIDE]; // epoch seen by each active reader; 0 if free
 } LIST;
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// key prefix functions for createListKey
+// prefixes compare as unsigned integers in the same order as the keys
+
+/* defines unsigned long long NAME(const void *) for an int field
+	the prefix is the whole key; use with LIST_EXACT_KEY
+*/
+#define LIST_INT_KEY(NAME, TYPE, FIELD) \
+static unsigned long long NAME( const void *dataPtr) \
+{ \
+	return (unsigned long long)(long long)((const TYPE *)dataPtr)->FIELD ^ 0x8000000000000000ULL; \
+}
+
+/* defines unsigned long long NAME(const void *) for a string field ordered by strcmp,
+	then by a char field (e.g. name, sex)
+	packs the first 7 bytes of the string big-endian;
+	strings shorter than 7 bytes also carry the char field in the last byte
+*/
+#define LIST_STR_KEY(NAME, TYPE, STR, CH) \
+static unsigned long long NAME( const void *dataPtr) \
+{ \
+	const unsigned char *s = (const unsigned char *)((const TYPE *)dataPtr)->STR; \
+	unsigned long long key = 0; \
+	int i; \
+	for (i = 0; i < 7 && s[i]; i++) key |= (unsigned long long)s[i] << (56 - 8 * i); \
+	if (i < 7) key |= (unsigned char)((const TYPE *)dataPtr)->CH; \
+	return key; \
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 // function declarations
@@ -25,10 +121,69 @@ typedef struct
 */
 LIST *createList( int (*compare)(const void *, const void *));
 
+/* Allocates dynamic memory for a list head node with LIST_* options
+	LIST_SKIP		adds the skip list express lane (see createSkipList)
+	LIST_NODE_POOL	allocates nodes from slabs with a free list instead of one malloc per node
+	LIST_DATA_ARENA	makes allocData/freeData use an arena owned by the list;
+					destroyList releases all payloads at once (callback may be NULL)
+	LIST_CONCURRENT	lets searchList/traverseList run in many threads while writers
+					(addNode, addNodesBulk, removeNode) are serialized by a lock
+	the unrolled list (adt_udlist.c) ignores LIST_SKIP and rejects LIST_CONCURRENT
+	return	head node pointer
+			NULL if overflow or an option is not supported
+*/
+LIST *createListEx( int (*compare)(const void *, const void *), int flags);
+
+/* Allocates dynamic memory for a list head node with a cached key prefix
+	keyOf returns an order-preserving 64-bit prefix of data (see LIST_INT_KEY, LIST_STR_KEY):
+	keyOf(a) < keyOf(b) must imply compare(a, b) < 0
+	each node caches the prefix, so compare is called only when prefixes are equal
+	(never with LIST_EXACT_KEY, where equal prefixes mean equal keys)
+	the unrolled list (adt_udlist.c) stores keyOf but does not use it
+	return	head node pointer
+			NULL if overflow or an option is not supported
+*/
+LIST *createListKey( int (*compare)(const void *, const void *), unsigned long long (*keyOf)(const void *), int flags);
+
+/* Allocates dynamic memory for a list head node with a skip list express lane
+	nodes get probabilistic towers over the llink/rlink chain,
+	so search, insert and delete take O(log N) expected time
+	return	head node pointer
+			NULL if overflow
+*/
+LIST *createSkipList( int (*compare)(const void *, const void *));
+
 /* Deletes all data in list and recycles memory
+	callback is called for each data unless it is NULL
+	node slabs and the payload arena are released at once
 */
 void destroyList( LIST *pList, void (*callback)(void *));
 
+/* Allocates memory for a payload
+	from the list arena if the list has LIST_DATA_ARENA, otherwise by malloc
+	return	pointer to size bytes (8-byte aligned)
+			NULL if overflow
+*/
+void *allocData( LIST *pList, size_t size);
+
+/* Recycles memory returned by allocData
+	size must be the size given to allocData
+*/
+void freeData( LIST *pList, void *dataPtr, size_t size);
+
+/* Enters a read-side critical section of a LIST_CONCURRENT list
+	nodes and data seen inside are not freed by removeNode until readUnlockList,
+	so data returned by searchList stays valid until then
+	must not be held by a thread calling addNode, addNodesBulk or removeNode
+	return	slot number to pass to readUnlockList
+			-1 if the list is not concurrent
+*/
+int readLockList( LIST *pList);
+
+/* Leaves a read-side critical section entered by readLockList
+*/
+void readUnlockList( LIST *pList, int slot);
+
 /* Inserts data into list
 	return	0 if overflow
 			1 if successful
@@ -36,13 +191,27 @@ void destroyList( LIST *pList, void (*callback)(void *));
 */
 int addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *, const void *));
 
+/* Inserts a batch of data into list
+	sorts dataInPtrs once (stable, by pList->compare) and merges it into the list in one pass
+	duplicated keys (with the list or within the batch) are passed to callback like addNode
+	on return, entries inserted into the list are set to NULL;
+	the remaining (duplicated) entries still belong to the caller
+	return	number of inserted nodes
+			-1 if overflow
+*/
+int addNodesBulk( LIST *pList, void **dataInPtrs, int count, void (*callback)(const void *, const void *));
+
 /* Removes data from list
+	in LIST_CONCURRENT mode, waits until no reader can see the node,
+	so the removed data may be freed as soon as this returns
 	return	0 not found
 			1 deleted
 */
 int removeNode( LIST *pList, void *keyPtr, void **dataOutPtr);
 
 /* interface to search function
+	safe to call from many threads of a LIST_CONCURRENT list;
+	hold readLockList to keep using dataOut after it returns
 	Argu	key being sought
 	dataOut	contains found data
 	return	1 successful
@@ -60,9 +229,11 @@ int countList( LIST *pList);
 int emptyList( LIST *pList);
 
 /* traverses data from list (forward)
+	safe to call from many threads of a LIST_CONCURRENT list
 */
 void traverseList( LIST *pList, void (*callback)(const void *));
 
 /* traverses data from list (backward)
+	safe to call from many threads of a LIST_CONCURRENT list
 */
 void traverseListR( LIST *pList, void (*callback)(const void *));
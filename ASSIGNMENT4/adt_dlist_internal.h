@@ -0,0 +1,93 @@
+// internal functions shared by adt_dlist.c and adt_udlist.c
+// included after adt_dlist.h, so each list compiles them against its own LIST type
+
+#include <stdlib.h> // malloc, free
+#include <string.h> // memcpy
+
+/* internal arena function
+	allocates size bytes (rounded up to 8) from the list arena
+	blocks of a size class recycled by _arenaFree are reused first
+	return	pointer to the block
+			NULL if memory overflow
+*/
+static void *_arenaAlloc( LIST *pList, size_t size){
+	size = (size + 7) & ~(size_t)7;
+	size_t cls = size / 8;
+	if(cls < ARENA_CLASSES && pList->freeBlock[cls] != NULL){
+		void *block = pList->freeBlock[cls];
+		pList->freeBlock[cls] = *(void **)block;
+		return block;
+	}
+	
+	if(pList->arenaPtr == NULL || (size_t)(pList->arenaEnd - pList->arenaPtr) < size){
+		//청크 앞 16바이트는 청크 리스트 연결에 사용
+		size_t chunkSize = (size + 16 > ARENA_CHUNK) ? size + 16 : ARENA_CHUNK;
+		char *chunk = (char *)malloc(chunkSize);
+		if(chunk == NULL) return NULL;
+		*(void **)chunk = pList->chunks;
+		pList->chunks = chunk;
+		
+		//큰 블록은 청크를 단독으로 사용하고 현재 청크는 그대로 둠
+		if(chunkSize > ARENA_CHUNK) return chunk + 16;
+		pList->arenaPtr = chunk + 16;
+		pList->arenaEnd = chunk + chunkSize;
+	}
+	void *block = pList->arenaPtr;
+	pList->arenaPtr += size;
+	return block;
+}
+
+/* internal arena function
+	recycles a block of the size given to _arenaAlloc
+*/
+static void _arenaFree( LIST *pList, void *block, size_t size){
+	size_t cls = ((size + 7) & ~(size_t)7) / 8;
+	if(cls >= ARENA_CLASSES) return; // released by destroyList
+	*(void **)block = pList->freeBlock[cls];
+	pList->freeBlock[cls] = block;
+}
+
+/* internal sort function
+	stable bottom-up merge sort of data pointers by pList->compare
+	already sorted runs cost one compare per element
+	return	1 if successful
+			0 if memory overflow
+*/
+static int _sortData( LIST *pList, void **arr, int count){
+	int i;
+	//이미 정렬된 경우
+	for(i=1; i<count; i++){
+		if(pList->compare(arr[i-1], arr[i]) > 0) break;
+	}
+	if(i >= count) return 1;
+	
+	void **temp = (void **)malloc(sizeof(void *) * count);
+	if(temp == NULL) return 0;
+	
+	void **src = arr;
+	void **dst = temp;
+	for(int width=1; width<count; width*=2){
+		for(int lo=0; lo<count; lo+=2*width){
+			int mid = (lo + width < count) ? lo + width : count;
+			int hi = (lo + 2*width < count) ? lo + 2*width : count;
+			int l = lo, r = mid, k = lo;
+			//두 구간의 경계가 이미 정렬되어 있으면 복사만
+			if(mid < hi && pList->compare(src[mid-1], src[mid]) <= 0){
+				memcpy(dst+lo, src+lo, sizeof(void *) * (hi-lo));
+				continue;
+			}
+			while(l < mid && r < hi){
+				if(pList->compare(src[r], src[l]) < 0) dst[k++] = src[r++];
+				else dst[k++] = src[l++];
+			}
+			while(l < mid) dst[k++] = src[l++];
+			while(r < hi) dst[k++] = src[r++];
+		}
+		void **t = src;
+		src = dst;
+		dst = t;
+	}
+	if(src != arr) memcpy(arr, src, sizeof(void *) * count);
+	free(temp);
+	return 1;
+}
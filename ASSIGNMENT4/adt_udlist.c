@@ -0,0 +1,382 @@
+#include <stdlib.h> // malloc
+#include <string.h> // memcpy, memmove
+
+#define UNROLLED_LIST
+#include "adt_dlist.h"
+#include "adt_dlist_internal.h"
+
+/* internal node allocation function
+	allocates an empty node linked after pPre (at the front if pPre is NULL)
+	with LIST_NODE_POOL, nodes come from the arena and are recycled through freeNode
+	return	node pointer
+			NULL if memory overflow
+*/
+static NODE *_newNode( LIST *pList, NODE *pPre){
+	NODE *node;
+	if(!(pList->flags & LIST_NODE_POOL)) node = (NODE *)malloc(sizeof(NODE));
+	else if(pList->freeNode != NULL){
+		node = pList->freeNode;
+		pList->freeNode = node->rlink;
+	}
+	else node = (NODE *)_arenaAlloc(pList, sizeof(NODE));
+	if(node == NULL) return NULL;
+
+	node->n = 0;
+	node->llink = pPre;
+	node->rlink = (pPre == NULL) ? pList->head : pPre->rlink;
+	if(node->rlink != NULL) node->rlink->llink = node;
+	else pList->rear = node;
+	if(pPre != NULL) pPre->rlink = node;
+	else pList->head = node;
+	return node;
+}
+
+/* internal node recycling function
+	unlinks an (empty) node from the list
+*/
+static void _freeNode( LIST *pList, NODE *node){
+	if(node->llink != NULL) node->llink->rlink = node->rlink;
+	else pList->head = node->rlink;
+	if(node->rlink != NULL) node->rlink->llink = node->llink;
+	else pList->rear = node->llink;
+
+	if(!(pList->flags & LIST_NODE_POOL)){
+		free(node);
+		return;
+	}
+	node->rlink = pList->freeNode;
+	pList->freeNode = node;
+}
+
+/* internal search function
+	finds the first data whose key is not less than pArgu
+	the node is found by comparing the last data of each node,
+	and the position in the node by binary search
+	pLoc	receives the node (NULL if all keys are less than pArgu)
+	pPos	receives the position in the node
+	return	1 found
+			0 not found
+*/
+static int _search( LIST *pList, NODE **pLoc, int *pPos, void *pArgu){
+	NODE *curNode = pList->head;
+	while(curNode != NULL && pList->compare(curNode->data[curNode->n-1], pArgu) < 0){
+		curNode = curNode->rlink;
+	}
+	*pLoc = curNode;
+	*pPos = 0;
+	if(curNode == NULL) return 0;
+
+	//노드의 마지막 데이터는 pArgu보다 작지 않음
+	int lo = 0, hi = curNode->n - 1;
+	while(lo < hi){
+		int mid = (lo + hi) / 2;
+		if(pList->compare(curNode->data[mid], pArgu) < 0) lo = mid + 1;
+		else hi = mid;
+	}
+	*pPos = lo;
+	return pList->compare(curNode->data[lo], pArgu) == 0;
+}
+
+/* internal insert function
+	inserts data at position *pPos of node *pLoc
+	a full node is split in half first; *pLoc and *pPos are updated to the new place of data
+	return	1 if successful
+			0 if memory overflow
+*/
+static int _insert( LIST *pList, NODE **pLoc, int *pPos, void *dataInPtr){
+	NODE *node = *pLoc;
+	int pos = *pPos;
+
+	//노드가 가득 찼으면 뒤쪽 절반을 새 노드로 옮김
+	if(node->n == UNROLL_SIZE){
+		NODE *next = _newNode(pList, node);
+		if(next == NULL) return 0;
+		int half = UNROLL_SIZE / 2;
+		memcpy(next->data, node->data + half, sizeof(void *) * (UNROLL_SIZE - half));
+		next->n = UNROLL_SIZE - half;
+		node->n = half;
+		if(pos > half){
+			node = next;
+			pos -= half;
+		}
+	}
+	memmove(node->data + pos + 1, node->data + pos, sizeof(void *) * (node->n - pos));
+	node->data[pos] = dataInPtr;
+	node->n++;
+	pList->count++;
+	*pLoc = node;
+	*pPos = pos;
+	return 1;
+}
+
+/* internal append function
+	inserts data after all data in list
+	return	1 if successful
+			0 if memory overflow
+*/
+static int _append( LIST *pList, void *dataInPtr){
+	//마지막 노드가 가득 찼으면 반으로 나누지 않고 새 노드를 붙임
+	if(pList->rear == NULL || pList->rear->n == UNROLL_SIZE){
+		if(_newNode(pList, pList->rear) == NULL) return 0;
+	}
+	pList->rear->data[pList->rear->n++] = dataInPtr;
+	pList->count++;
+	return 1;
+}
+
+/* internal delete function
+	deletes data from a list and saves the (deleted) data to dataOut
+	a node shrunk below a quarter is merged into its next node if they fit in one
+*/
+static void _delete( LIST *pList, NODE *pLoc, int pos, void **dataOutPtr){
+	*dataOutPtr = pLoc->data[pos];
+	memmove(pLoc->data + pos, pLoc->data + pos + 1, sizeof(void *) * (pLoc->n - pos - 1));
+	pLoc->n--;
+	pList->count--;
+
+	if(pLoc->n == 0){
+		_freeNode(pList, pLoc);
+		return;
+	}
+	NODE *next = pLoc->rlink;
+	if(pLoc->n < UNROLL_SIZE / 4 && next != NULL && pLoc->n + next->n <= UNROLL_SIZE){
+		memcpy(pLoc->data + pLoc->n, next->data, sizeof(void *) * next->n);
+		pLoc->n += next->n;
+		_freeNode(pList, next);
+	}
+}
+
+/* Allocates dynamic memory for a list head node and returns its address to caller
+	return	head node pointer
+			NULL if overflow
+*/
+LIST *createList( int (*compare)(const void *, const void *)){
+	return createListEx(compare, 0);
+}
+
+/* Allocates dynamic memory for a list head node with LIST_* options
+	LIST_SKIP		is ignored; searches already skip whole nodes
+	LIST_NODE_POOL	allocates nodes from the arena and recycles them
+	LIST_DATA_ARENA	makes allocData/freeData use an arena owned by the list;
+					destroyList releases all payloads at once (callback may be NULL)
+	LIST_CONCURRENT	is not supported
+	return	head node pointer
+			NULL if overflow
+*/
+LIST *createListEx( int (*compare)(const void *, const void *), int flags){
+	return createListKey(compare, NULL, flags);
+}
+
+/* Allocates dynamic memory for a list head node
+	the unrolled list keeps no per-data key prefix; keyOf is stored but not used
+	return	head node pointer
+			NULL if overflow or LIST_CONCURRENT (not supported by the unrolled list)
+*/
+LIST *createListKey( int (*compare)(const void *, const void *), unsigned long long (*keyOf)(const void *), int flags){
+	if(flags & LIST_CONCURRENT) return NULL;
+	LIST *ptr = (LIST *)malloc(sizeof(LIST));
+	if(ptr == NULL) return NULL;
+	ptr->count = 0;
+	ptr->head = NULL;
+	ptr->rear = NULL;
+	ptr->compare = compare;
+	ptr->keyOf = keyOf;
+	ptr->flags = flags;
+	ptr->freeNode = NULL;
+	ptr->arenaPtr = ptr->arenaEnd = NULL;
+	ptr->chunks = NULL;
+	for(int i=0; i<ARENA_CLASSES; i++) ptr->freeBlock[i] = NULL;
+	return ptr;
+}
+
+/* Allocates dynamic memory for a list head node
+	the unrolled list has no express lane; this is the same as createList
+	return	head node pointer
+			NULL if overflow
+*/
+LIST *createSkipList( int (*compare)(const void *, const void *)){
+	return createListEx(compare, LIST_SKIP);
+}
+
+/* Deletes all data in list and recycles memory
+	callback is called for each data unless it is NULL
+	pooled nodes and the payload arena are released at once
+*/
+void destroyList( LIST *pList, void (*callback)(void *)){
+	NODE *curNode = pList->head;
+	while(curNode != NULL){
+		NODE *temp = curNode->rlink;
+		if(callback != NULL){
+			for(int i=0; i<curNode->n; i++) callback(curNode->data[i]);
+		}
+		if(!(pList->flags & LIST_NODE_POOL)) free(curNode);
+		curNode = temp;
+	}
+
+	while(pList->chunks != NULL){
+		void *next = *(void **)pList->chunks;
+		free(pList->chunks);
+		pList->chunks = next;
+	}
+	free(pList);
+}
+
+/* Allocates memory for a payload
+	from the list arena if the list has LIST_DATA_ARENA, otherwise by malloc
+	return	pointer to size bytes (8-byte aligned)
+			NULL if overflow
+*/
+void *allocData( LIST *pList, size_t size){
+	if(pList->flags & LIST_DATA_ARENA) return _arenaAlloc(pList, size);
+	return malloc(size);
+}
+
+/* Recycles memory returned by allocData
+	size must be the size given to allocData
+*/
+void freeData( LIST *pList, void *dataPtr, size_t size){
+	if(pList->flags & LIST_DATA_ARENA) _arenaFree(pList, dataPtr, size);
+	else free(dataPtr);
+}
+
+/* Enters a read-side critical section
+	the unrolled list is never concurrent (createListEx rejects LIST_CONCURRENT)
+	return	-1
+*/
+int readLockList( LIST *pList){
+	(void)pList;
+	return -1;
+}
+
+/* Leaves a read-side critical section entered by readLockList
+	nothing to do for the unrolled list
+*/
+void readUnlockList( LIST *pList, int slot){
+	(void)pList;
+	(void)slot;
+}
+
+/* Inserts data into list
+	return	0 if overflow
+			1 if successful
+			2 if duplicated key
+*/
+int addNode( LIST *pList, void *dataInPtr, void (*callback)(const void *, const void *)){
+	NODE *pLoc;
+	int pos;
+	if(_search(pList, &pLoc, &pos, dataInPtr)){
+		callback(pLoc->data[pos], dataInPtr);
+		return 2;
+	}
+	if(pLoc == NULL) return _append(pList, dataInPtr);
+	return _insert(pList, &pLoc, &pos, dataInPtr);
+}
+
+/* Inserts a batch of data into list
+	sorts dataInPtrs once (stable, by pList->compare) and merges it into the list in one pass
+	duplicated keys (with the list or within the batch) are passed to callback like addNode
+	on return, entries inserted into the list are set to NULL;
+	the remaining (duplicated) entries still belong to the caller
+	return	number of inserted nodes
+			-1 if overflow
+*/
+int addNodesBulk( LIST *pList, void **dataInPtrs, int count, void (*callback)(const void *, const void *)){
+	if(!_sortData(pList, dataInPtrs, count)) return -1;
+
+	NODE *curNode = pList->head;	// 삽입 위치의 노드
+	int pos = 0;					// 노드 안의 삽입 위치
+	void *last = NULL;				// 직전 데이터와 같은 키를 가진 데이터
+	int inserted = 0;
+
+	for(int i=0; i<count; i++){
+		void *dataInPtr = dataInPtrs[i];
+
+		//배치 안에서 직전 데이터와 같은 키
+		if(last != NULL && pList->compare(last, dataInPtr) == 0){
+			callback(last, dataInPtr);
+			continue;
+		}
+
+		//마지막 데이터가 dataInPtr보다 작은 노드를 건너뜀
+		while(curNode != NULL && pList->compare(curNode->data[curNode->n-1], dataInPtr) < 0){
+			curNode = curNode->rlink;
+			pos = 0;
+		}
+
+		//리스트의 모든 데이터보다 큼
+		if(curNode == NULL){
+			if(!_append(pList, dataInPtr)) return -1;
+		}
+		else{
+			int ret;
+			while((ret = pList->compare(curNode->data[pos], dataInPtr)) < 0) pos++;
+
+			//리스트에 이미 키가 존재할 때
+			if(ret == 0){
+				callback(curNode->data[pos], dataInPtr);
+				last = curNode->data[pos];
+				continue;
+			}
+			if(!_insert(pList, &curNode, &pos, dataInPtr)) return -1;
+		}
+		last = dataInPtr;
+		dataInPtrs[i] = NULL;
+		inserted++;
+	}
+	return inserted;
+}
+
+/* Removes data from list
+	return	0 not found
+			1 deleted
+*/
+int removeNode( LIST *pList, void *keyPtr, void **dataOutPtr){
+	NODE *pLoc;
+	int pos;
+	if(_search(pList, &pLoc, &pos, keyPtr) == 0) return 0;
+	_delete(pList, pLoc, pos, dataOutPtr);
+	return 1;
+}
+
+/* interface to search function
+	Argu	key being sought
+	dataOut	contains found data
+	return	1 successful
+			0 not found
+*/
+int searchList( LIST *pList, void *pArgu, void **dataOutPtr){
+	NODE *pLoc;
+	int pos;
+	if(_search(pList, &pLoc, &pos, pArgu) == 0) return 0;
+	*dataOutPtr = pLoc->data[pos];
+	return 1;
+}
+
+/* returns number of nodes in list
+*/
+int countList( LIST *pList){
+	return pList->count;
+}
+
+/* returns	1 empty
+			0 list has data
+*/
+int emptyList( LIST *pList){
+	return pList->count == 0 ? 1 : 0;
+}
+
+/* traverses data from list (forward)
+*/
+void traverseList( LIST *pList, void (*callback)(const void *)){
+	for(NODE *curNode = pList->head; curNode != NULL; curNode = curNode->rlink){
+		for(int i=0; i<curNode->n; i++) callback(curNode->data[i]);
+	}
+}
+
+/* traverses data from list (backward)
+*/
+void traverseListR( LIST *pList, void (*callback)(const void *)){
+	for(NODE *curNode = pList->rear; curNode != NULL; curNode = curNode->llink){
+		for(int i=curNode->n-1; i>=0; i--) callback(curNode->data[i]);
+	}
+}
@@ -0,0 +1,106 @@
+#include <stdlib.h> // realloc, qsort, free
+#include <ctype.h> // toupper
+#include <time.h> // clock_gettime
+
+#include "batch.h"
+
+// latency samples of one batch command
+typedef struct
+{
+	int		len;
+	int		capacity;
+	double	*data; // seconds
+} tLatency;
+
+static double get_time(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void add_latency( tLatency *lat, double t)
+{
+	if (lat->len == lat->capacity)
+	{
+		lat->capacity = lat->capacity ? lat->capacity * 2 : 1024;
+		lat->data = (double *)realloc( lat->data, sizeof(double) * lat->capacity);
+	}
+	lat->data[lat->len++] = t;
+}
+
+static int cmp_double( const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+	return (x > y) - (x < y);
+}
+
+// prints latency percentiles of a command to stderr
+static void print_latency( const char *label, tLatency *lat)
+{
+	if (lat->len == 0) return;
+	qsort( lat->data, lat->len, sizeof(double), cmp_double);
+	
+	double p50 = lat->data[(int)(0.50 * (lat->len - 1))];
+	double p90 = lat->data[(int)(0.90 * (lat->len - 1))];
+	double p99 = lat->data[(int)(0.99 * (lat->len - 1))];
+	double max = lat->data[lat->len - 1];
+	fprintf( stderr, "%s\t%d\tp50 %.2f us\tp90 %.2f us\tp99 %.2f us\tmax %.2f us\n",
+		label, lat->len, p50 * 1e6, p90 * 1e6, p99 * 1e6, max * 1e6);
+	free( lat->data);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/* runs commands from a script (see batch.h)
+	P and B are not timed
+*/
+void run_batch( void *list, FILE *fp, tBatchCommand command)
+{
+	tLatency search = {0, 0, NULL};
+	tLatency delete = {0, 0, NULL};
+	tLatency count = {0, 0, NULL};
+	char str[1024];
+	char ch;
+	
+	// results are written in blocks, not per line
+	setvbuf( stdout, NULL, _IOFBF, 1 << 16);
+	
+	while (fscanf( fp, " %c", &ch) == 1)
+	{
+		ch = toupper( ch);
+		if (ch == 'Q') break;
+		if (ch == 'S' || ch == 'D')
+		{
+			if (fscanf( fp, "%1023s", str) != 1) break;
+		}
+		
+		double start_time = get_time();
+		switch( ch)
+		{
+			case 'P':
+			case 'B':
+				command( list, ch, NULL);
+				break;
+			
+			case 'S':
+				command( list, ch, str);
+				add_latency( &search, get_time() - start_time);
+				break;
+			
+			case 'D':
+				command( list, ch, str);
+				add_latency( &delete, get_time() - start_time);
+				break;
+			
+			case 'C':
+				command( list, ch, NULL);
+				add_latency( &count, get_time() - start_time);
+				break;
+		}
+	}
+	fflush( stdout);
+	
+	print_latency( "S)earch", &search);
+	print_latency( "D)elete", &delete);
+	print_latency( "C)ount", &count);
+}
@@ -0,0 +1,16 @@
+#include <stdio.h> // FILE
+
+// batch mode of the name_dlist programs (ASSIGNMENT3/name_dlist.c, ASSIGNMENT4/name.c)
+
+/* runs one batch command on list
+	cmd is 'P', 'B', 'S', 'D' or 'C'
+	arg is the name/sex argument of S and D, ex) "Zoe/F"; NULL for the others
+*/
+typedef void (*tBatchCommand)( void *list, char cmd, char *arg);
+
+/* runs S/D/C (and P/B/Q) commands from a script without prompts
+	the script has the same form as the interactive input, ex) "S Zoe/F"
+	each command is passed to command
+	prints latency percentiles of S, D and C to stderr at the end
+*/
+void run_batch( void *list, FILE *fp, tBatchCommand command);
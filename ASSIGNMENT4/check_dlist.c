@@ -0,0 +1,181 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, rand
+#include <limits.h> // INT_MIN, INT_MAX
+
+#include "adt_dlist.h"
+
+#define NUMBERS		20000	// insert operations per list
+#define MAX_ITEMS	(2 * NUMBERS + 64)
+
+// data of the check
+typedef struct
+{
+	int		key;
+	int		count;	// number of inserts of key (duplicates add up)
+} tItem;
+
+// key prefix of tItem for createListKey (the whole key)
+LIST_INT_KEY( keyItem, tItem, key)
+
+static long compareCalls = 0;
+static int errors = 0;
+
+// keys seen by the traversal callback
+static int walk[MAX_ITEMS];
+static int walkCount[MAX_ITEMS];
+static int walkLen;
+
+/* compare function for tItem
+	no subtraction, so INT_MIN and INT_MAX do not overflow
+*/
+int cmpItem( const void *p1, const void *p2)
+{
+	int k1 = ((const tItem *)p1)->key;
+	int k2 = ((const tItem *)p2)->key;
+	compareCalls++;
+	return (k1 > k2) - (k1 < k2);
+}
+
+/* duplicated key: counts the insert
+*/
+void dupItem( const void *dataInList, const void *dataIn)
+{
+	((tItem *)dataInList)->count += ((const tItem *)dataIn)->count;
+}
+
+/* traverseList callback: records the keys in order
+*/
+void recordItem( const void *dataPtr)
+{
+	if (walkLen == MAX_ITEMS) return;
+	walk[walkLen] = ((const tItem *)dataPtr)->key;
+	walkCount[walkLen++] = ((const tItem *)dataPtr)->count;
+}
+
+/* reports a difference between the two lists
+*/
+void fail( const char *msg, int key)
+{
+	errors++;
+	if (errors <= 10) fprintf( stderr, "error: %s (key %d)\n", msg, key);
+}
+
+/* random int over the whole range, with the edge values and small keys mixed in
+*/
+int randomKey( unsigned int *seed)
+{
+	static const int edges[] = { INT_MIN, INT_MIN + 1, -1, 0, 1, INT_MAX - 1, INT_MAX };
+	int r = rand_r( seed) % 8;
+
+	if (r == 0) return edges[rand_r( seed) % 7];
+	if (r == 1) return rand_r( seed) % 201 - 100; // many duplicates
+	return (int)(((unsigned int)rand_r( seed) << 16) ^ (unsigned int)rand_r( seed) ^ ((unsigned int)rand_r( seed) << 31));
+}
+
+/* adds a copy of key to list
+	return	return value of addNode
+*/
+int addKey( LIST *list, int key)
+{
+	tItem *item = (tItem *)malloc( sizeof(tItem));
+	item->key = key;
+	item->count = 1;
+	int ret = addNode( list, item, dupItem);
+	if (ret != 1) free( item);
+	return ret;
+}
+
+/* runs the same operations on a callback-only list and a LIST_INT_KEY | LIST_EXACT_KEY list
+	and compares every result and the final order
+*/
+void check( int flags)
+{
+	LIST *plain = createListEx( cmpItem, flags);
+	LIST *keyed = createListKey( cmpItem, keyItem, flags | LIST_EXACT_KEY);
+	unsigned int seed = 1;
+	long keyedCalls = 0;
+
+	if (!plain || !keyed)
+	{
+		fail( "cannot create list", 0);
+		return;
+	}
+
+	for (int i = 0; i < NUMBERS; i++)
+	{
+		tItem key;
+		void *p1, *p2;
+		int r1, r2;
+		key.key = randomKey( &seed);
+
+		switch (rand_r( &seed) % 4)
+		{
+			case 0: // remove
+				r1 = removeNode( plain, &key, &p1);
+				compareCalls = 0;
+				r2 = removeNode( keyed, &key, &p2);
+				keyedCalls += compareCalls;
+				if (r1 != r2) fail( "removeNode results differ", key.key);
+				if (r1 && ((tItem *)p1)->count != ((tItem *)p2)->count) fail( "removed counts differ", key.key);
+				if (r1) free( p1);
+				if (r2) free( p2);
+				break;
+
+			case 1: // search
+				r1 = searchList( plain, &key, &p1);
+				compareCalls = 0;
+				r2 = searchList( keyed, &key, &p2);
+				keyedCalls += compareCalls;
+				if (r1 != r2) fail( "searchList results differ", key.key);
+				if (r1 && r2 && ((tItem *)p2)->key != key.key) fail( "searchList found another key", key.key);
+				break;
+
+			default: // insert
+				r1 = addKey( plain, key.key);
+				compareCalls = 0;
+				r2 = addKey( keyed, key.key);
+				keyedCalls += compareCalls;
+				if (r1 != r2) fail( "addNode results differ", key.key);
+				break;
+		}
+	}
+
+	// both lists must hold the same keys in signed order
+	int plainLen, plainKeys[MAX_ITEMS], plainCounts[MAX_ITEMS];
+	walkLen = 0;
+	traverseList( plain, recordItem);
+	plainLen = walkLen;
+	for (int i = 0; i < walkLen; i++)
+	{
+		plainKeys[i] = walk[i];
+		plainCounts[i] = walkCount[i];
+	}
+	walkLen = 0;
+	traverseList( keyed, recordItem);
+
+	if (walkLen != plainLen || countList( plain) != countList( keyed)) fail( "counts differ", walkLen);
+	for (int i = 0; i < walkLen && i < plainLen; i++)
+	{
+		if (walk[i] != plainKeys[i] || walkCount[i] != plainCounts[i]) fail( "lists differ", walk[i]);
+		if (i > 0 && walk[i-1] >= walk[i]) fail( "keyed list out of order", walk[i]);
+	}
+
+	// LIST_EXACT_KEY decides every comparison with the cached prefix
+	if (keyedCalls != 0) fail( "compare called on the LIST_EXACT_KEY list", (int)keyedCalls);
+
+	fprintf( stdout, "flags %2d: %d keys from %d to %d, compare called %ld times on the keyed list, %d errors so far\n",
+		flags, walkLen, walkLen ? walk[0] : 0, walkLen ? walk[walkLen-1] : 0, keyedCalls, errors);
+
+	destroyList( plain, free);
+	destroyList( keyed, free);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( void)
+{
+	check( 0);
+	check( LIST_SKIP);
+	check( LIST_SKIP | LIST_NODE_POOL);
+
+	return errors ? 1 : 0;
+}
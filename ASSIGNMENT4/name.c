@@ -4,6 +4,7 @@
 #include <ctype.h> // toupper
 
 #include "adt_dlist.h"
+#include "batch.h"
 
 #define QUIT			1
 #define FORWARD_PRINT	2
@@ -12,6 +13,8 @@
 #define DELETE			5
 #define COUNT			6
 
+#define BATCH_SIZE		65536 // number of names merged into the list at once
+
 
 // User structure type definition
 typedef struct 
@@ -32,6 +35,16 @@ tName *createName( char *str, char sex, int freq);
 */
 void destroyName( void *pName);
 
+/* Allocates a name structure and its name string in one block from the list's payload arena
+	return	name structure pointer
+			NULL if overflow
+*/
+tName *allocName( LIST *list, char *str, char sex, int freq);
+
+/* Recycles a name structure returned by allocName
+*/
+void freeName( LIST *list, tName *pName);
+
 ////////////////////////////////////////////////////////////////////////////////
 // prints contents of name structure
 // for traverseList and traverseListR functions
@@ -105,6 +118,58 @@ int cmpName( const void *pName1, const void *pName2)
 	else return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/* runs one command of run_batch (see batch.h)
+	searches and deletes use one key on the stack instead of createName
+*/
+void batch_command( void *list, char cmd, char *arg)
+{
+	tName key;
+	void *p;
+	
+	if (arg)
+	{
+		key.sex = 0;
+		split_name_sex( arg, &key.sex); // unknown format is reported and not found
+		key.name = arg;
+		key.freq = 0;
+	}
+	
+	switch( cmd)
+	{
+		case 'P':
+			traverseList( (LIST *)list, print_name);
+			break;
+		
+		case 'B':
+			traverseListR( (LIST *)list, print_name);
+			break;
+		
+		case 'S':
+			if (searchList( (LIST *)list, &key, &p)) print_name( p);
+			else fprintf( stdout, "%s not found\n", arg);
+			break;
+		
+		case 'D':
+			if (removeNode( (LIST *)list, &key, &p))
+			{
+				fprintf( stdout, "(%s, %c, %d) deleted\n", ((tName *)p)->name, ((tName *)p)->sex, ((tName *)p)->freq);
+				freeName( (LIST *)list, (tName *)p);
+			}
+			else fprintf( stdout, "%s not found\n", arg);
+			break;
+		
+		case 'C':
+			fprintf( stdout, "%d\n", countList( (LIST *)list));
+			break;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// key prefix of (name, sex) cached in list nodes
+// for createListKey function
+LIST_STR_KEY( keyName, tName, name, sex)
+
 ////////////////////////////////////////////////////////////////////////////////
 int main( int argc, char **argv)
 {
@@ -117,9 +182,24 @@ int main( int argc, char **argv)
 	tName *pName;
 	int ret;
 	FILE *fp;
+	FILE *script = NULL;
+	
+	// batch mode
+	if (argc == 4 && strcmp( argv[1], "--batch") == 0)
+	{
+		script = fopen( argv[2], "rt");
+		if (!script)
+		{
+			fprintf( stderr, "Error: cannot open file [%s]\n", argv[2]);
+			return 2;
+		}
+		argv[2] = argv[0];
+		argv += 2;
+		argc -= 2;
+	}
 	
 	if (argc != 2){
-		fprintf( stderr, "usage: %s FILE\n", argv[0]);
+		fprintf( stderr, "usage: %s [--batch SCRIPT] FILE\n", argv[0]);
 		return 1;
 	}
 	
@@ -131,7 +211,7 @@ int main( int argc, char **argv)
 	}
 	
 	// creates an empty list
-	list = createList( cmpName);
+	list = createListKey( cmpName, keyName, LIST_SKIP | LIST_NODE_POOL | LIST_DATA_ARENA);
 	if (!list)
 	{
 		printf( "Cannot create list\n");
@@ -140,20 +220,38 @@ int main( int argc, char **argv)
 	
 	void *p;
 	
-	while(fscanf( fp, "%*d\t%s\t%c\t%d", str, &sex, &freq) != EOF)
+	// reads names in batches and merges each batch into the list at once
+	void **batch = (void **)malloc( sizeof(void *) * BATCH_SIZE);
+	int count = 0;
+	
+	do
 	{
-		pName = createName( str, sex, freq);
+		ret = fscanf( fp, "%*d\t%s\t%c\t%d", str, &sex, &freq);
+		if (ret != EOF) batch[count++] = allocName( list, str, sex, freq);
 		
-		ret = addNode( list, pName, increase_freq);
-		
-		if (ret == 2) // duplicated
+		if (count == BATCH_SIZE || (ret == EOF && count > 0))
 		{
-			destroyName( pName);
+			addNodesBulk( list, batch, count, increase_freq);
+			
+			for (int i = 0; i < count; i++)
+			{
+				if (batch[i]) freeName( list, batch[i]); // duplicated
+			}
+			count = 0;
 		}
-	}
+	} while (ret != EOF);
 	
+	free( batch);
 	fclose( fp);
 	
+	if (script)
+	{
+		run_batch( list, script, batch_command);
+		fclose( script);
+		destroyList( list, NULL); // names are released with the arena
+		return 0;
+	}
+	
 	fprintf( stderr, "Select Q)uit, P)rint, B)ackward print, S)earch, D)elete, C)ount: ");
 	
 	while (1)
@@ -164,7 +262,7 @@ int main( int argc, char **argv)
 		switch( action)
 		{
 			case QUIT:
-				destroyList( list, destroyName);
+				destroyList( list, NULL); // names are released with the arena
 				return 0;
 			
 			case FORWARD_PRINT:
@@ -198,7 +296,7 @@ int main( int argc, char **argv)
 				if (removeNode( list, pName, &p))
 				{
 					fprintf( stdout, "(%s, %c, %d) deleted\n", ((tName *)p)->name, ((tName *)p)->sex, ((tName *)p)->freq);
-					destroyName( (tName *)p);
+					freeName( list, (tName *)p);
 				}
 				else fprintf( stdout, "%s not found\n", str);
 				
@@ -239,3 +337,26 @@ void destroyName( void *pName){
 	free(pNode->name);
 	free(pNode);
 }
+
+/* Allocates a name structure and its name string in one block from the list's payload arena
+	return	name structure pointer
+			NULL if overflow
+*/
+tName *allocName( LIST *list, char *str, char sex, int freq){
+	size_t len = strlen(str);
+	tName *ptr;
+	if(ptr = (tName *)allocData(list, sizeof(tName) + len + 1)){
+		ptr->name = (char *)(ptr + 1);
+		memcpy(ptr->name, str, len + 1);
+		ptr->sex = sex;
+		ptr->freq = freq;
+		return ptr;
+	}
+	return NULL;
+}
+
+/* Recycles a name structure returned by allocName
+*/
+void freeName( LIST *list, tName *pName){
+	freeData(list, pName, sizeof(tName) + strlen(pName->name) + 1);
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h> // malloc, atoi, rand_r
+#include <string.h> // strcmp
+#include <pthread.h>
+
+#include "adt_dlist.h"
+
+#define WRITERS		2
+#define READERS		4
+#define KEY_SPACE	512		// keys 0 ~ KEY_SPACE-1
+#define MAGIC		0x5a5a5a5a
+
+// data of the stress test
+typedef struct
+{
+	int		key;
+	int		magic;	// MAGIC while the data may be in the list; cleared just before free
+} tItem;
+
+static LIST *list;
+static int iterations = 1000;
+static volatile int writersDone = 0;
+static int errors = 0;
+
+// per-thread state of the traversal callbacks
+static __thread int lastKey;
+static __thread int visited;
+
+/* compare function for tItem
+*/
+int cmpItem( const void *p1, const void *p2)
+{
+	return ((const tItem *)p1)->key - ((const tItem *)p2)->key;
+}
+
+/* duplicated key: the new data stays with the writer
+*/
+void dupItem( const void *dataInList, const void *dataIn)
+{
+}
+
+/* reports an error found by a thread
+*/
+void fail( const char *msg, int key)
+{
+	__atomic_add_fetch( &errors, 1, __ATOMIC_RELAXED);
+	fprintf( stderr, "error: %s (key %d)\n", msg, key);
+}
+
+/* traverseList callback: keys must increase and the data must be alive
+*/
+void checkForward( const void *dataPtr)
+{
+	const tItem *item = (const tItem *)dataPtr;
+	if (item->magic != MAGIC) fail( "freed data in forward traversal", item->key);
+	if (visited && item->key <= lastKey) fail( "forward traversal out of order", item->key);
+	lastKey = item->key;
+	visited++;
+}
+
+/* traverseListR callback: keys must decrease and the data must be alive
+*/
+void checkBackward( const void *dataPtr)
+{
+	const tItem *item = (const tItem *)dataPtr;
+	if (item->magic != MAGIC) fail( "freed data in backward traversal", item->key);
+	if (visited && item->key >= lastKey) fail( "backward traversal out of order", item->key);
+	lastKey = item->key;
+	visited++;
+}
+
+/* inserts and removes random keys
+*/
+void *writer( void *arg)
+{
+	unsigned int seed = (unsigned int)(long)arg;
+
+	for (int i = 0; i < iterations; i++)
+	{
+		tItem key;
+		key.key = rand_r( &seed) % KEY_SPACE;
+
+		if (rand_r( &seed) % 2)
+		{
+			tItem *item = (tItem *)malloc( sizeof(tItem));
+			item->key = key.key;
+			item->magic = MAGIC;
+			if (addNode( list, item, dupItem) != 1) free( item);
+		}
+		else
+		{
+			void *dataOut;
+			// removeNode returns after readers can no longer see the node
+			if (removeNode( list, &key, &dataOut))
+			{
+				((tItem *)dataOut)->magic = 0;
+				free( dataOut);
+			}
+		}
+	}
+	return NULL;
+}
+
+/* searches and traverses while writers run
+*/
+void *reader( void *arg)
+{
+	unsigned int seed = (unsigned int)(long)arg;
+	long rounds = 0;
+
+	while (!__atomic_load_n( &writersDone, __ATOMIC_ACQUIRE))
+	{
+		tItem key;
+		void *dataOut;
+		key.key = rand_r( &seed) % KEY_SPACE;
+
+		// data found stays valid while the read section is held
+		int slot = readLockList( list);
+		if (searchList( list, &key, &dataOut))
+		{
+			const tItem *item = (const tItem *)dataOut;
+			if (item->magic != MAGIC || item->key != key.key) fail( "searchList returned bad data", key.key);
+		}
+		readUnlockList( list, slot);
+
+		visited = 0;
+		traverseList( list, checkForward);
+		visited = 0;
+		traverseListR( list, checkBackward);
+		rounds++;
+	}
+	return (void *)rounds;
+}
+
+/* checks that llink and rlink are mirror images and the chain is sorted
+	return	number of nodes
+*/
+int checkLinks( LIST *pList)
+{
+	int count = 0;
+	NODE *prev = NULL;
+
+	for (NODE *node = pList->head; node != NULL; node = node->rlink)
+	{
+		if (node->llink != prev) fail( "llink does not mirror rlink", ((tItem *)node->dataPtr)->key);
+		if (prev && cmpItem( prev->dataPtr, node->dataPtr) >= 0) fail( "chain out of order", ((tItem *)node->dataPtr)->key);
+		prev = node;
+		count++;
+	}
+	if (pList->rear != prev) fail( "rear is not the last node", -1);
+	if (count != countList( pList)) fail( "count does not match the chain", count);
+	return count;
+}
+
+/* releases data left in the list
+*/
+void freeItem( void *dataPtr)
+{
+	free( dataPtr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int flags = LIST_CONCURRENT;
+	pthread_t writers[WRITERS];
+	pthread_t readers[READERS];
+
+	// express lane (-s), node pool (-p)
+	while (argc >= 2 && (strcmp( argv[1], "-s") == 0 || strcmp( argv[1], "-p") == 0))
+	{
+		if (argv[1][1] == 's') flags |= LIST_SKIP;
+		else flags |= LIST_NODE_POOL;
+		argv[1] = argv[0];
+		argv++;
+		argc--;
+	}
+	if (argc == 2) iterations = atoi( argv[1]);
+	if (argc > 2 || iterations <= 0)
+	{
+		fprintf( stderr, "usage: %s [-s] [-p] [ITERATIONS]\n", argv[0]);
+		return 1;
+	}
+
+	list = createListEx( cmpItem, flags);
+	if (!list)
+	{
+		printf( "Cannot create list\n");
+		return 100;
+	}
+
+	for (long i = 0; i < READERS; i++) pthread_create( &readers[i], NULL, reader, (void *)(i + 100));
+	for (long i = 0; i < WRITERS; i++) pthread_create( &writers[i], NULL, writer, (void *)(i + 1));
+
+	for (int i = 0; i < WRITERS; i++) pthread_join( writers[i], NULL);
+	__atomic_store_n( &writersDone, 1, __ATOMIC_RELEASE);
+
+	long rounds = 0;
+	for (int i = 0; i < READERS; i++)
+	{
+		void *ret;
+		pthread_join( readers[i], &ret);
+		rounds += (long)ret;
+	}
+
+	// writers are done: the chain must be whole
+	int count = checkLinks( list);
+
+	fprintf( stdout, "%d writers x %d operations, %d readers x %ld rounds, %d nodes left, %d errors\n",
+		WRITERS, iterations, READERS, rounds / READERS, count, errors);
+
+	destroyList( list, freeItem);
+
+	return errors ? 1 : 0;
+}
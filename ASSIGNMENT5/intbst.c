@@ -1,11 +1,20 @@
 #include <stdlib.h> // malloc, atoi, rand
 #include <stdio.h>
+#include <string.h> // strcmp, memcpy
+#include <limits.h> // UINT_MAX
 #include <assert.h>
 #include <time.h> // time
 
 #define RANDOM_INPUT	1
 #define FILE_INPUT		2
 
+// tree types for BST_Create
+#define BST_PLAIN		0 // unbalanced binary search tree
+#define BST_TREAP		1 // randomized balanced tree (O(log N) expected height)
+#define BST_ARENA		2 // flag: nodes come from slabs released at once by BST_Destroy
+
+#define SLAB_SIZE		1024 // nodes per slab
+
 ////////////////////////////////////////////////////////////////////////////////
 // TREE type definition
 typedef struct node
@@ -13,27 +22,57 @@ typedef struct node
 	int			data;
 	struct node	*left;
 	struct node	*right;
+	unsigned int priority; // heap-ordered random priority (BST_TREAP)
+	int			size;	// number of nodes in the subtree
 } NODE;
 
 typedef struct
 {
 	NODE	*root;
+	int		type;	// BST_PLAIN or BST_TREAP
+	unsigned int seed;	// random state for priorities
+	int		arena;		// 1 if nodes come from slabs (BST_ARENA)
+	NODE	*freeList;	// deleted nodes of the slabs, linked by right
+	NODE	*slabNode;	// next unused node in the current slab
+	NODE	*slabEnd;	// end of the current slab
+	void	*slabs;		// node slabs (linked through their first word)
 } TREE;
 
+// in-order cursor
+// nodes are not linked to their parents, so the path is kept on an explicit stack
+typedef struct
+{
+	TREE	*pTree;
+	NODE	**stack;	// nodes not returned yet whose left subtrees are done; top is the next
+	int		top;
+	int		capacity;
+} CURSOR;
+
+// read-only snapshot of a tree in Eytzinger (BFS) order
+// children of keys[k] are keys[2k] and keys[2k+1]; keys[0] is unused
+// a lookup touches one array instead of malloc-scattered nodes
+typedef struct
+{
+	int		*keys;	// 64-byte aligned so keys[16k..16k+15] share a cache line
+	int		count;
+} FROZEN;
+
 ////////////////////////////////////////////////////////////////////////////////
 // Prototype declarations
 
 /* Allocates dynamic memory for a tree head node and returns its address to caller
+	type	BST_PLAIN or BST_TREAP, optionally with BST_ARENA
 	return	head node pointer
 			NULL if overflow
 */
-TREE *BST_Create( void);
+TREE *BST_Create( int type);
 
 /* Deletes all data in tree and recycles memory
 */
 void BST_Destroy( TREE *pTree);
 
 /* internal function (not mandatory)
+	frees nodes one by one with O(1) extra space
 */
 static void _destroy( NODE *root);
 
@@ -49,6 +88,18 @@ static void _insert( NODE *root, NODE *newPtr);
 
 NODE *_makeNode( int data);
 
+/* internal function
+	takes a node from the free list or the slabs (BST_ARENA), or a new node
+	return	node pointer
+			NULL if overflow
+*/
+static NODE *_allocNode( TREE *pTree, int data);
+
+/* internal function
+	puts a node on the free list (BST_ARENA) or frees it
+*/
+static void _freeNode( TREE *pTree, NODE *node);
+
 /* Deletes a node with dltKey from the tree
 	return	1 success
 			0 not found
@@ -59,7 +110,7 @@ int BST_Delete( TREE *pTree, int dltKey);
 	success is 1 if deleted; 0 if not
 	return	pointer to root
 */
-static NODE *_delete( NODE *root, int dltKey, int *success);
+static NODE *_delete( TREE *pTree, NODE *root, int dltKey, int *success);
 
 /* Retrieve tree for the node containing the requested key
 	return	address of data of the node containing the key
@@ -74,6 +125,25 @@ int *BST_Retrieve( TREE *pTree, int key);
 */
 static NODE *_retrieve( NODE *root, int key);
 
+/* internal treap functions
+	insert and delete keep the priorities heap-ordered by rotations
+	(equal keys may end up on either side after a rotation; in-order stays sorted)
+	return	pointer to root
+*/
+static NODE *_treapInsert( NODE *root, NODE *newPtr);
+static NODE *_treapDelete( TREE *pTree, NODE *root, int dltKey, int *success);
+
+/* internal treap function
+	merges two treaps whose keys are all in order (left before right)
+	return	pointer to root
+*/
+static NODE *_treapJoin( NODE *left, NODE *right);
+
+/* Computes the height and the average depth of nodes (root depth is 0)
+	height is 0 for an empty tree and 1 for a single node
+*/
+void BST_Stats( TREE *pTree, int *height, double *avgDepth);
+
 /* prints tree using inorder traversal
 */
 void BST_Traverse( TREE *pTree);
@@ -86,6 +156,100 @@ void printTree( TREE *pTree);
 */
 static void _inorder_print( NODE *root, int level);
 
+/* Allocates dynamic memory for an in-order cursor over the tree
+	the cursor is invalid after the tree is modified until BST_Begin or BST_Seek
+	return	cursor pointer
+			NULL if overflow
+*/
+CURSOR *BST_CursorCreate( TREE *pTree);
+
+/* Recycles memory of the cursor
+*/
+void BST_CursorDestroy( CURSOR *pCursor);
+
+/* Moves the cursor before the smallest data
+	return	1 success
+			0 overflow
+*/
+int BST_Begin( CURSOR *pCursor);
+
+/* Moves the cursor before the first data not less than key
+	return	1 success
+			0 overflow
+*/
+int BST_Seek( CURSOR *pCursor, int key);
+
+/* Returns data at the cursor and advances it in order
+	return	address of data
+			NULL if there is no more data (or overflow)
+*/
+int *BST_Next( CURSOR *pCursor);
+
+/* internal cursor function
+	pushes node onto the stack
+	return	1 success
+			0 overflow
+*/
+static int _push( CURSOR *pCursor, NODE *node);
+
+/* internal cursor function
+	pushes node and its left spine onto the stack
+	return	1 success
+			0 overflow
+*/
+static int _pushLeft( CURSOR *pCursor, NODE *node);
+
+/* Copies the data of the tree into a contiguous Eytzinger-ordered snapshot
+	later changes to the tree are not reflected in the snapshot
+	return	snapshot pointer
+			NULL if overflow
+*/
+FROZEN *BST_Freeze( TREE *pTree);
+
+/* Recycles memory of the snapshot
+*/
+void BST_FrozenDestroy( FROZEN *pFrozen);
+
+/* Retrieve data in the snapshot with index arithmetic
+	return	address of data (the first one if duplicated)
+			NULL not found
+*/
+int *BST_FrozenRetrieve( FROZEN *pFrozen, int key);
+
+/* Builds a height-optimal tree from data sorted in ascending order in O(N)
+	all nodes are placed in one contiguous allocation in order,
+	so the tree is always a BST_ARENA tree whatever type says:
+	later inserts also come from slabs, deleted nodes are recycled, and BST_Destroy frees the memory at once
+	type	BST_PLAIN or BST_TREAP (BST_ARENA is implied)
+	return	head node pointer
+			NULL if overflow
+*/
+TREE *BST_BuildFromSorted( int type, const int *data, int count);
+
+/* Sorts a copy of data and builds a height-optimal tree with BST_BuildFromSorted
+	the tree is always a BST_ARENA tree (see BST_BuildFromSorted)
+	return	head node pointer
+			NULL if overflow
+*/
+TREE *BST_BuildFromUnsorted( int type, const int *data, int count);
+
+/* internal function
+	qsort compare function for int data
+*/
+static int _compareInt( const void *a, const void *b);
+
+/* Rebuilds the tree into a height-optimal shape in O(N), reusing its nodes
+*/
+void BST_Rebalance( TREE *pTree);
+
+/* internal function
+	builds a height-optimal tree from the first count nodes of *list (linked by right in order)
+	and advances *list past them
+	index is the heap index of the subtree root (1 for the root); priorities decrease with it
+	return	pointer to root
+*/
+static NODE *_build( NODE **list, int count, unsigned long index);
+
 /* 
 	return 1 if the tree is empty; 0 if not
 */
@@ -93,16 +257,104 @@ int BST_Empty( TREE *pTree);
 
 NODE *minVal(NODE* root);
 
+/* Returns the k-th smallest data (k starts from 0)
+	return	address of data
+			NULL if k is out of range
+*/
+int *BST_Select( TREE *pTree, int k);
+
+/* Returns the number of data less than key
+	BST_Select( pTree, BST_Rank( pTree, key)) is the first data not less than key
+*/
+int BST_Rank( TREE *pTree, int key);
+
+/* Returns the number of data in [lo, hi]
+*/
+int BST_RangeCount( TREE *pTree, int lo, int hi);
+
+/* internal function
+	counts data less than key (orEqual 0) or not greater than key (orEqual 1)
+*/
+static int _countLess( NODE *root, int key, int orEqual);
+
+/* internal function
+	return	number of nodes in the subtree (0 for NULL)
+*/
+static int _size( NODE *root);
+
+/* internal function
+	recomputes the size of node from its children
+*/
+static void _update( NODE *root);
+
+/* Times insert, retrieve (in the tree and in a BST_Freeze snapshot) and delete of numbers random data
+	and BST_Rebalance / BST_BuildFromSorted of the same data
+*/
+void run_bench( int type, int numbers);
+
+/* Checks BST_Select, BST_Rank and BST_RangeCount against an in-order walk
+	of numbers random data (1 ~ numbers * 3) after deleting a third of them,
+	again after BST_Rebalance and on a copy made by BST_BuildFromSorted,
+	and checks that BST_Rebalance makes numbers sorted inserts height-optimal
+	return	number of errors
+*/
+int run_check( int type, int numbers);
+
+/* internal function of run_check
+	compares the order statistics of the tree with walk (its count data in order)
+	less[key] is the number of data less than key (0 <= key <= maxKey + 1)
+	return	number of errors
+*/
+static int _checkOrder( TREE *pTree, const int *walk, int count, const int *less, int maxKey);
+
+/* internal function of run_check
+	return	1 if the tree is not height-optimal for count nodes; 0 if it is
+*/
+static int _checkHeight( TREE *pTree, int count);
+
+/* internal function of run_check
+	return	number of nodes whose priority is lower than a child's (heap order of a treap)
+*/
+static int _checkPriority( NODE *root);
+
+double get_time( void);
+
 ////////////////////////////////////////////////////////////////////////////////
 int main( int argc, char **argv)
 {
 	int mode; // input mode
+	int type = BST_PLAIN;
+	int bulk = 0;
 	TREE *tree;
 	int data;
 	
+	// balanced tree (-t), build at once from FILE (-s), nodes from slabs (-a)
+	while (argc >= 3 && (strcmp( argv[1], "-t") == 0 || strcmp( argv[1], "-s") == 0 || strcmp( argv[1], "-a") == 0))
+	{
+		if (argv[1][1] == 't') type |= BST_TREAP;
+		else if (argv[1][1] == 'a') type |= BST_ARENA;
+		else bulk = 1;
+		argv[1] = argv[0];
+		argv++;
+		argc--;
+	}
+	
+	// benchmark
+	if (argc == 3 && strcmp( argv[1], "-b") == 0)
+	{
+		run_bench( type, atoi( argv[2]));
+		return 0;
+	}
+	
+	// order statistics check
+	if (argc == 3 && strcmp( argv[1], "-c") == 0)
+	{
+		return run_check( type, atoi( argv[2])) ? 1 : 0;
+	}
+	
 	if (argc != 2)
 	{
-		fprintf( stderr, "usage: %s FILE or %s number\n", argv[0], argv[0]);
+		fprintf( stderr, "usage: %s [-t] [-a] [-s] FILE or %s [-t] [-a] [-b | -c] number\n", argv[0], argv[0]);
 		return 1;
 	}
 	
@@ -115,7 +367,7 @@ int main( int argc, char **argv)
 	else mode = FILE_INPUT;
 	
 	// creates a null tree
-	tree = BST_Create();
+	tree = BST_Create( type);
 	
 	if (!tree)
 	{
@@ -145,20 +397,56 @@ int main( int argc, char **argv)
 	}
 	else if (mode == FILE_INPUT)
 	{
+		int *buffer = NULL;
+		int count = 0;
+		int capacity = 0;
+		
 		fprintf( stdout, "Inserting: ");
 		
 		while (fscanf( fp, "%d", &data) != EOF)
 		{
 			fprintf( stdout, "%d ", data);
 			
+			if (bulk)
+			{
+				if (count == capacity)
+				{
+					capacity = capacity ? capacity * 2 : 1024;
+					int *temp = (int *)realloc( buffer, sizeof(int) * capacity);
+					if (!temp) break;
+					buffer = temp;
+				}
+				buffer[count++] = data;
+				continue;
+			}
+			
 			// insert function call
 			int ret = BST_Insert( tree, data);
 			if (!ret) break;
 		}
 		fclose( fp);
+		
+		// builds a balanced tree at once
+		if (bulk)
+		{
+			BST_Destroy( tree);
+			tree = BST_BuildFromUnsorted( type, buffer, count);
+			free( buffer);
+			if (!tree)
+			{
+				printf( "Cannot create a tree!\n");
+				return 100;
+			}
+		}
 	}
 	
 	fprintf( stdout, "\n");
+	
+	// shape of the tree
+	int height;
+	double avgDepth;
+	BST_Stats( tree, &height, &avgDepth);
+	fprintf( stderr, "Height: %d, average depth: %.2f\n", height, avgDepth);
 
 	if (BST_Empty( tree))
 	{
@@ -210,9 +498,17 @@ int main( int argc, char **argv)
 	return	head node pointer
 			NULL if overflow
 */
-TREE *BST_Create( void){
+TREE *BST_Create( int type){
 	TREE *ptr = (TREE *)malloc(sizeof(TREE));
+	if(ptr == NULL) return NULL;
 	ptr->root = NULL;
+	ptr->type = type & ~BST_ARENA;
+	ptr->seed = 2463534242u;
+	ptr->arena = (type & BST_ARENA) != 0;
+	ptr->freeList = NULL;
+	ptr->slabNode = NULL;
+	ptr->slabEnd = NULL;
+	ptr->slabs = NULL;
 	return ptr;
 }	
 
@@ -220,19 +516,38 @@ TREE *BST_Create( void){
 */
 void BST_Destroy( TREE *pTree){
 	
-	if(pTree->root != NULL) _destroy(pTree->root);
+	//슬랩에서 온 노드는 슬랩 단위로 한꺼번에 해제
+	if(pTree->arena){
+		void *slab = pTree->slabs;
+		while(slab != NULL){
+			void *next = *(void **)slab;
+			free(slab);
+			slab = next;
+		}
+	}
+	else if(pTree->root != NULL) _destroy(pTree->root);
 	free(pTree);
 }
 
 /* internal function (not mandatory)
+	frees nodes one by one with O(1) extra space
 */
 static void _destroy( NODE *root){
-	while(root->left != NULL && root->right != NULL){
-		if(root->left != NULL) _destroy(root->left);
-		if(root->right != NULL) _destroy(root->right);
+	//왼쪽 자식이 있으면 오른쪽 회전으로 끌어올리고, 없으면 루트를 지우고 오른쪽으로 감
+	//회전마다 왼쪽 링크가 하나씩 줄어 O(N)에 끝나며 스택이 필요 없음
+	while(root != NULL){
+		if(root->left == NULL){
+			NODE *next = root->right;
+			free(root);
+			root = next;
+		}
+		else{
+			NODE *temp = root->left;
+			root->left = temp->right;
+			temp->right = root;
+			root = temp;
+		}
 	}
-	root->data = 0;
-	free(root);
 }
 
 /* Inserts new data into the tree
@@ -241,8 +556,15 @@ static void _destroy( NODE *root){
 */
 int BST_Insert( TREE *pTree, int data){
 	NODE *newNode;
-	if(newNode = _makeNode(data)){
-		if(pTree->root == NULL) pTree->root = newNode;
+	if(newNode = _allocNode(pTree, data)){
+		if(pTree->type == BST_TREAP){
+			pTree->seed ^= pTree->seed << 13;
+			pTree->seed ^= pTree->seed >> 17;
+			pTree->seed ^= pTree->seed << 5;
+			newNode->priority = pTree->seed;
+			pTree->root = _treapInsert(pTree->root, newNode);
+		}
+		else if(pTree->root == NULL) pTree->root = newNode;
 		else _insert(pTree->root, newNode);
 		return 1;
 	}
@@ -252,13 +574,15 @@ int BST_Insert( TREE *pTree, int data){
 /* internal function (not mandatory)
 */
 static void _insert( NODE *root, NODE *newPtr){
-	if(root->data > newPtr->data){
-		if(root->left == NULL) root->left = newPtr;
-		else _insert(root->left, newPtr);
-	}
-	else{
-		if(root->right == NULL) root->right = newPtr;
-		else _insert(root->right, newPtr);
+	//빈 자리를 찾을 때까지 내려감 (같은 키는 오른쪽)
+	while(1){
+		root->size++;
+		NODE **link = (root->data > newPtr->data) ? &root->left : &root->right;
+		if(*link == NULL){
+			*link = newPtr;
+			return;
+		}
+		root = *link;
 	}
 }
 
@@ -267,9 +591,56 @@ NODE *_makeNode( int data){
 	ptr->data = data;
 	ptr->left = NULL;
 	ptr->right = NULL;
+	ptr->priority = 0;
+	ptr->size = 1;
 	return ptr;
 }
 
+/* internal function
+	takes a node from the free list or the slabs (BST_ARENA), or a new node
+	return	node pointer
+			NULL if overflow
+*/
+static NODE *_allocNode( TREE *pTree, int data){
+	NODE *ptr;
+	if(!pTree->arena) return _makeNode(data);
+	
+	if(pTree->freeList != NULL){
+		ptr = pTree->freeList;
+		pTree->freeList = ptr->right;
+	}
+	else{
+		if(pTree->slabNode == pTree->slabEnd){
+			//슬랩의 첫 노드 자리는 슬랩 리스트 연결에 사용
+			NODE *slab = (NODE *)malloc(sizeof(NODE) * (SLAB_SIZE + 1));
+			if(slab == NULL) return NULL;
+			*(void **)slab = pTree->slabs;
+			pTree->slabs = slab;
+			pTree->slabNode = slab + 1;
+			pTree->slabEnd = slab + SLAB_SIZE + 1;
+		}
+		ptr = pTree->slabNode++;
+	}
+	ptr->data = data;
+	ptr->left = NULL;
+	ptr->right = NULL;
+	ptr->priority = 0;
+	ptr->size = 1;
+	return ptr;
+}
+
+/* internal function
+	puts a node on the free list (BST_ARENA) or frees it
+*/
+static void _freeNode( TREE *pTree, NODE *node){
+	if(!pTree->arena){
+		free(node);
+		return;
+	}
+	node->right = pTree->freeList;
+	pTree->freeList = node;
+}
+
 /* Deletes a node with dltKey from the tree
 	return	1 success
 			0 not found
@@ -278,7 +649,8 @@ int BST_Delete( TREE *pTree, int dltKey){
 	int success = 0;
 	if(_retrieve(pTree->root, dltKey) != NULL)
 	{
-		pTree->root = _delete(pTree->root, dltKey, &success);
+		if(pTree->type == BST_TREAP) pTree->root = _treapDelete(pTree, pTree->root, dltKey, &success);
+		else pTree->root = _delete(pTree, pTree->root, dltKey, &success);
 		return 1;
 	}
 	return 0;
@@ -288,32 +660,118 @@ int BST_Delete( TREE *pTree, int dltKey){
 	success is 1 if deleted; 0 if not
 	return	pointer to root
 */
-static NODE *_delete( NODE *root, int dltKey, int *success){
+static NODE *_delete( TREE *pTree, NODE *root, int dltKey, int *success){
+	//지울 노드를 가리키는 링크를 찾음
+	NODE **link = &root;
+	while(*link != NULL && (*link)->data != dltKey){
+		link = (dltKey < (*link)->data) ? &(*link)->left : &(*link)->right;
+	}
+	if(*link == NULL) return root;
+	
+	//찾은 노드까지의 경로의 크기를 줄임
+	NODE *node = *link;
+	for(NODE *p = root; p != node; p = (dltKey < p->data) ? p->left : p->right) p->size--;
 	
-	if(root == NULL) return root;
+	if(node->left == NULL){
+		*link = node->right;
+		_freeNode(pTree, node);
+	}
+	else if(node->right == NULL){
+		*link = node->left;
+		_freeNode(pTree, node);
+	}
+	else{
+		//오른쪽 서브트리의 최솟값을 가져오고 그 노드를 지움
+		NODE **minLink = &node->right;
+		node->size--;
+		while((*minLink)->left != NULL){
+			(*minLink)->size--;
+			minLink = &(*minLink)->left;
+		}
+		NODE *temp = *minLink;
+		node->data = temp->data;
+		*minLink = temp->right;
+		_freeNode(pTree, temp);
+	}
+	*success = 1;
+	return root;
+}
+
+/* internal treap functions
+	insert and delete keep the priorities heap-ordered by rotations
+	(equal keys may end up on either side after a rotation; in-order stays sorted)
+	recursion depth is the tree height, O(log N) expected
+	return	pointer to root
+*/
+static NODE *_treapInsert( NODE *root, NODE *newPtr){
+	if(root == NULL) return newPtr;
+	
+	if(root->data > newPtr->data){
+		root->left = _treapInsert(root->left, newPtr);
+		root->size++;
+		//오른쪽 회전
+		if(root->left->priority > root->priority){
+			NODE *temp = root->left;
+			root->left = temp->right;
+			temp->right = root;
+			_update(root);
+			_update(temp);
+			return temp;
+		}
+	}
+	else{
+		root->right = _treapInsert(root->right, newPtr);
+		root->size++;
+		//왼쪽 회전
+		if(root->right->priority > root->priority){
+			NODE *temp = root->right;
+			root->right = temp->left;
+			temp->left = root;
+			_update(root);
+			_update(temp);
+			return temp;
+		}
+	}
+	return root;
+}
+
+static NODE *_treapDelete( TREE *pTree, NODE *root, int dltKey, int *success){
+	if(root == NULL) return NULL;
 	
 	if(dltKey < root->data){
-		root->left = _delete(root->left, dltKey, success);
+		root->left = _treapDelete(pTree, root->left, dltKey, success);
 	}
 	else if(dltKey > root->data){
-		root->right = _delete(root->right, dltKey, success);
+		root->right = _treapDelete(pTree, root->right, dltKey, success);
 	}
 	else{
-        if (root->left == NULL) {
-            NODE* temp = root->right;
-            free(root);
-            return temp;
-        }
-        else if (root->right == NULL) {
-            NODE* temp = root->left;
-            free(root);
-            return temp;
-        }
-        NODE* temp = minVal(root->right);
-        root->data = temp->data;
-        root->right = _delete(root->right, temp->data, success);
-    }
-    return root;
+		//두 서브트리를 합쳐 노드 자리에 둠
+		NODE *temp = _treapJoin(root->left, root->right);
+		_freeNode(pTree, root);
+		*success = 1;
+		return temp;
+	}
+	_update(root);
+	return root;
+}
+
+/* internal treap function
+	merges two treaps whose keys are all in order (left before right)
+	return	pointer to root
+*/
+static NODE *_treapJoin( NODE *left, NODE *right){
+	if(left == NULL) return right;
+	if(right == NULL) return left;
+	
+	//우선순위가 높은 쪽이 루트가 됨
+	if(left->priority > right->priority){
+		left->right = _treapJoin(left->right, right);
+		_update(left);
+		return left;
+	}
+	right->left = _treapJoin(left, right->left);
+	_update(right);
+	return right;
 }
 
 NODE *minVal(NODE* root){
@@ -337,11 +795,10 @@ int *BST_Retrieve( TREE *pTree, int key){
 			NULL not found
 */
 static NODE *_retrieve( NODE *root, int key){
-	if(root == NULL) return NULL;
-	if(root->data == key) return root;
-	
-	if(key > root->data) return _retrieve(root->right, key);
-	else return _retrieve(root->left, key);
+	while(root != NULL && root->data != key){
+		root = (key > root->data) ? root->right : root->left;
+	}
+	return root;
 }
 
 /* prints tree using inorder traversal
@@ -350,9 +807,12 @@ void BST_Traverse( TREE *pTree){
 	_traverse(pTree->root);
 }
 static void _traverse( NODE *root){
-	if(root->left != NULL) _traverse(root->left);
-	printf(" %d",root->data);
-	if(root->right != NULL) _traverse(root->right);
+	CURSOR cursor = {NULL, NULL, 0, 0};
+	int *data;
+	
+	if(!_pushLeft(&cursor, root)) return;
+	while((data = BST_Next(&cursor)) != NULL) printf(" %d", *data);
+	free(cursor.stack);
 }
 
 /* Print tree using inorder right-to-left traversal
@@ -365,18 +825,651 @@ void printTree( TREE *pTree){
 /* internal traversal function
 */
 static void _inorder_print( NODE *root, int level){
-	if(root->right != NULL) _inorder_print(root->right, level+1);
+	//오른쪽부터 중위 순회하며 (노드, 깊이)를 스택에 쌓음
+	struct { NODE *node; int level; } *stack = NULL;
+	int capacity = 0;
+	int top = 0;
 	
-	for(int i=0; i<level; i++) printf("\t");
-	printf("%d\n", root->data);
-	
-	if(root->left != NULL) _inorder_print(root->left, level+1);
+	while(root != NULL || top > 0){
+		while(root != NULL){
+			if(top == capacity){
+				capacity = capacity ? capacity * 2 : 64;
+				void *temp = realloc(stack, sizeof(*stack) * capacity);
+				if(temp == NULL){
+					free(stack);
+					return;
+				}
+				stack = temp;
+			}
+			stack[top].node = root;
+			stack[top++].level = level++;
+			root = root->right;
+		}
+		top--;
+		root = stack[top].node;
+		level = stack[top].level;
+		
+		for(int i=0; i<level; i++) printf("\t");
+		printf("%d\n", root->data);
+		
+		root = root->left;
+		level++;
+	}
+	free(stack);
 }
 
+
 /* 
 	return 1 if the tree is empty; 0 if not
 */
 int BST_Empty( TREE *pTree){
 	if(pTree->root == NULL) return 1;
 	else return 0;
-}
\ No newline at end of file
+}
+
+/* Allocates dynamic memory for an in-order cursor over the tree
+	the cursor is invalid after the tree is modified until BST_Begin or BST_Seek
+	return	cursor pointer
+			NULL if overflow
+*/
+CURSOR *BST_CursorCreate( TREE *pTree){
+	CURSOR *ptr = (CURSOR *)malloc(sizeof(CURSOR));
+	if(ptr == NULL) return NULL;
+	ptr->pTree = pTree;
+	ptr->stack = NULL;
+	ptr->top = 0;
+	ptr->capacity = 0;
+	return ptr;
+}
+
+/* Recycles memory of the cursor
+*/
+void BST_CursorDestroy( CURSOR *pCursor){
+	free(pCursor->stack);
+	free(pCursor);
+}
+
+/* Moves the cursor before the smallest data
+	return	1 success
+			0 overflow
+*/
+int BST_Begin( CURSOR *pCursor){
+	pCursor->top = 0;
+	return _pushLeft(pCursor, pCursor->pTree->root);
+}
+
+/* Moves the cursor before the first data not less than key
+	return	1 success
+			0 overflow
+*/
+int BST_Seek( CURSOR *pCursor, int key){
+	NODE *node = pCursor->pTree->root;
+	pCursor->top = 0;
+	
+	//왼쪽으로 내려가는 노드만 이후에 방문하므로 스택에 남김
+	while(node != NULL){
+		if(node->data >= key){
+			if(!_push(pCursor, node)) return 0;
+			node = node->left;
+		}
+		else node = node->right;
+	}
+	return 1;
+}
+
+/* Returns data at the cursor and advances it in order
+	return	address of data
+			NULL if there is no more data (or overflow)
+*/
+int *BST_Next( CURSOR *pCursor){
+	if(pCursor->top == 0) return NULL;
+	NODE *node = pCursor->stack[--pCursor->top];
+	if(!_pushLeft(pCursor, node->right)) return NULL;
+	return &node->data;
+}
+
+/* internal cursor function
+	pushes node onto the stack
+	return	1 success
+			0 overflow
+*/
+static int _push( CURSOR *pCursor, NODE *node){
+	if(pCursor->top == pCursor->capacity){
+		int capacity = pCursor->capacity ? pCursor->capacity * 2 : 64;
+		NODE **stack = (NODE **)realloc(pCursor->stack, sizeof(NODE *) * capacity);
+		if(stack == NULL) return 0;
+		pCursor->stack = stack;
+		pCursor->capacity = capacity;
+	}
+	pCursor->stack[pCursor->top++] = node;
+	return 1;
+}
+
+/* internal cursor function
+	pushes node and its left spine onto the stack
+	return	1 success
+			0 overflow
+*/
+static int _pushLeft( CURSOR *pCursor, NODE *node){
+	while(node != NULL){
+		if(!_push(pCursor, node)) return 0;
+		node = node->left;
+	}
+	return 1;
+}
+
+/* Copies the data of the tree into a contiguous Eytzinger-ordered snapshot
+	later changes to the tree are not reflected in the snapshot
+	return	snapshot pointer
+			NULL if overflow
+*/
+FROZEN *BST_Freeze( TREE *pTree){
+	FROZEN *ptr = (FROZEN *)malloc(sizeof(FROZEN));
+	CURSOR *cursor = BST_CursorCreate(pTree);
+	int count = _size(pTree->root);
+	int *data;
+	
+	if(ptr == NULL || cursor == NULL) goto overflow;
+	
+	size_t size = (sizeof(int) * (count + 1) + 63) / 64 * 64;
+	ptr->keys = (int *)aligned_alloc(64, size);
+	if(ptr->keys == NULL) goto overflow;
+	ptr->count = count;
+	
+	//정렬된 순서대로 암시적 완전 이진트리를 중위 순회하며 채움
+	int k = 1;
+	while(2 * k <= count) k *= 2;
+	if(!BST_Begin(cursor)){
+		free(ptr->keys);
+		goto overflow;
+	}
+	while((data = BST_Next(cursor)) != NULL){
+		ptr->keys[k] = *data;
+		if(2 * k + 1 <= count){
+			k = 2 * k + 1;
+			while(2 * k <= count) k *= 2;
+		}
+		else{
+			//오른쪽 자식인 동안 올라간 뒤 한 번 더 올라감
+			while(k & 1) k >>= 1;
+			k >>= 1;
+		}
+	}
+	BST_CursorDestroy(cursor);
+	return ptr;
+	
+overflow:
+	if(cursor != NULL) BST_CursorDestroy(cursor);
+	free(ptr);
+	return NULL;
+}
+
+/* Recycles memory of the snapshot
+*/
+void BST_FrozenDestroy( FROZEN *pFrozen){
+	free(pFrozen->keys);
+	free(pFrozen);
+}
+
+/* Retrieve data in the snapshot with index arithmetic
+	return	address of data (the first one if duplicated)
+			NULL not found
+*/
+int *BST_FrozenRetrieve( FROZEN *pFrozen, int key){
+	int *keys = pFrozen->keys;
+	int count = pFrozen->count;
+	unsigned int k = 1;
+	
+	//분기 없이 내려가며 4단계 아래 자손들(한 캐시 라인)을 미리 읽음
+	while(k <= (unsigned int)count){
+#ifdef __GNUC__
+		__builtin_prefetch(keys + 16 * k);
+#endif
+		k = 2 * k + (keys[k] < key);
+	}
+	//마지막으로 왼쪽으로 내려간 노드가 key 이상인 첫 데이터
+	//(끝의 1비트들과 그 위의 0비트 하나를 버림)
+#ifdef __GNUC__
+	k >>= __builtin_ffs(~k);
+#else
+	while(k & 1) k >>= 1;
+	k >>= 1;
+#endif
+	if(k == 0 || keys[k] != key) return NULL;
+	return &keys[k];
+}
+
+/* Computes the height and the average depth of nodes (root depth is 0)
+	height is 0 for an empty tree and 1 for a single node
+*/
+void BST_Stats( TREE *pTree, int *height, double *avgDepth){
+	struct { NODE *node; int depth; } *stack = NULL;
+	int capacity = 0;
+	int top = 0;
+	long count = 0;
+	long sum = 0;
+	
+	*height = 0;
+	*avgDepth = 0;
+	if(pTree->root == NULL) return;
+	
+	//전위 순회하며 깊이를 더함
+	capacity = 64;
+	stack = malloc(sizeof(*stack) * capacity);
+	if(stack == NULL) return;
+	stack[top].node = pTree->root;
+	stack[top++].depth = 0;
+	
+	while(top > 0){
+		top--;
+		NODE *node = stack[top].node;
+		int depth = stack[top].depth;
+		count++;
+		sum += depth;
+		if(depth + 1 > *height) *height = depth + 1;
+		
+		if(top + 2 > capacity){
+			capacity *= 2;
+			void *temp = realloc(stack, sizeof(*stack) * capacity);
+			if(temp == NULL) break;
+			stack = temp;
+		}
+		if(node->left != NULL){
+			stack[top].node = node->left;
+			stack[top++].depth = depth + 1;
+		}
+		if(node->right != NULL){
+			stack[top].node = node->right;
+			stack[top++].depth = depth + 1;
+		}
+	}
+	free(stack);
+	*avgDepth = (double)sum / count;
+}
+
+double get_time( void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Times insert, retrieve (in the tree and in a BST_Freeze snapshot) and delete of numbers random data
+	and BST_Rebalance / BST_BuildFromSorted of the same data
+*/
+void run_bench( int type, int numbers){
+	TREE *tree = BST_Create( type);
+	int *data = (int *)malloc(sizeof(int) * numbers);
+	long found = 0;
+	assert( numbers > 0 && tree && data);
+	
+	srand(1);
+	for(int i=0; i<numbers; i++) data[i] = rand();
+	
+	double start_time = get_time();
+	for(int i=0; i<numbers; i++) BST_Insert(tree, data[i]);
+	double insert_time = get_time() - start_time;
+	
+	//섞은 순서로 찾고 지움
+	for(int i=numbers-1; i>0; i--){
+		int j = rand() % (i + 1);
+		int temp = data[i];
+		data[i] = data[j];
+		data[j] = temp;
+	}
+	start_time = get_time();
+	for(int i=0; i<numbers; i++) found += BST_Retrieve(tree, data[i]) != NULL;
+	double retrieve_time = get_time() - start_time;
+	
+	//같은 순서로 스냅샷에서 찾음 (트리와 결과가 같아야 함)
+	FROZEN *frozen = BST_Freeze( tree);
+	long frozenFound = 0;
+	assert( frozen);
+	start_time = get_time();
+	for(int i=0; i<numbers; i++) frozenFound += BST_FrozenRetrieve(frozen, data[i]) != NULL;
+	double frozen_time = get_time() - start_time;
+	BST_FrozenDestroy( frozen);
+	assert( frozenFound == found);
+	
+	start_time = get_time();
+	for(int i=0; i<numbers; i++) BST_Delete(tree, data[i]);
+	double delete_time = get_time() - start_time;
+	
+	//다시 채운 트리를 해제하는 시간
+	for(int i=0; i<numbers; i++) BST_Insert(tree, data[i]);
+	start_time = get_time();
+	BST_Destroy( tree);
+	double destroy_time = get_time() - start_time;
+	
+	fprintf( stdout, "%s%s %d: insert %.1f ns, retrieve %.1f ns, frozen retrieve %.1f ns, delete %.1f ns, destroy %.1f ns per op, %.1f bytes per data (%ld found)\n",
+		(type & BST_TREAP) ? "Treap" : "BST", (type & BST_ARENA) ? " (arena)" : "", numbers,
+		insert_time * 1e9 / numbers, retrieve_time * 1e9 / numbers, frozen_time * 1e9 / numbers, delete_time * 1e9 / numbers,
+		destroy_time * 1e9 / numbers, (double)sizeof(NODE), found);
+	
+	//하나씩 넣어 만든 트리를 다시 균형 맞추는 시간
+	int height, rebalancedHeight;
+	double avgDepth, rebalancedDepth;
+	tree = BST_Create( type);
+	assert( tree);
+	for(int i=0; i<numbers; i++) BST_Insert(tree, data[i]);
+	BST_Stats( tree, &height, &avgDepth);
+	start_time = get_time();
+	BST_Rebalance( tree);
+	double rebalance_time = get_time() - start_time;
+	BST_Stats( tree, &rebalancedHeight, &rebalancedDepth);
+	BST_Destroy( tree);
+	
+	//정렬된 데이터로 한 번에 만드는 시간
+	qsort( data, numbers, sizeof(int), _compareInt);
+	start_time = get_time();
+	tree = BST_BuildFromSorted( type, data, numbers);
+	double build_time = get_time() - start_time;
+	assert( tree);
+	BST_Destroy( tree);
+	
+	fprintf( stdout, "%s%s %d: rebalance %.1f ns, build from sorted %.1f ns per data, height %d -> %d, average depth %.2f -> %.2f\n",
+		(type & BST_TREAP) ? "Treap" : "BST", (type & BST_ARENA) ? " (arena)" : "", numbers,
+		rebalance_time * 1e9 / numbers, build_time * 1e9 / numbers, height, rebalancedHeight, avgDepth, rebalancedDepth);
+	
+	free( data);
+}
+
+/* Checks BST_Select, BST_Rank and BST_RangeCount against an in-order walk
+	of numbers random data (1 ~ numbers * 3) after deleting a third of them,
+	again after BST_Rebalance and on a copy made by BST_BuildFromSorted,
+	and checks that BST_Rebalance makes numbers sorted inserts height-optimal
+	return	number of errors
+*/
+int run_check( int type, int numbers){
+	TREE *tree = BST_Create( type);
+	int maxKey = numbers * 3 + 1;
+	int *walk = (int *)malloc(sizeof(int) * numbers);
+	int *less = (int *)malloc(sizeof(int) * (maxKey + 2));	// less[key]: number of data less than key
+	int count = 0;
+	int errors = 0;
+	int *data;
+	assert( numbers > 0 && tree && walk && less);
+	
+	srand(1);
+	for(int i=0; i<numbers; i++) BST_Insert(tree, rand() % (numbers * 3) + 1);
+	for(int i=0; i<numbers/3; i++) BST_Delete(tree, rand() % (numbers * 3) + 1);
+	
+	//중위 순회 결과를 기준으로 사용
+	CURSOR *cursor = BST_CursorCreate( tree);
+	assert( cursor && BST_Begin( cursor));
+	while((data = BST_Next(cursor)) != NULL) walk[count++] = *data;
+	BST_CursorDestroy( cursor);
+	
+	for(int key=0, i=0; key<=maxKey+1; key++){
+		while(i < count && walk[i] < key) i++;
+		less[key] = i;
+	}
+	
+	errors += _checkOrder(tree, walk, count, less, maxKey);
+	
+	//모양이 바뀌어도 같은 결과여야 함
+	BST_Rebalance( tree);
+	errors += _checkHeight(tree, count) + _checkOrder(tree, walk, count, less, maxKey);
+	if(type & BST_TREAP) errors += _checkPriority(tree->root);
+	BST_Destroy( tree);
+	
+	tree = BST_BuildFromSorted( type, walk, count);
+	assert( tree);
+	errors += _checkHeight(tree, count) + _checkOrder(tree, walk, count, less, maxKey);
+	
+	//만든 트립에 임의 우선순위의 노드를 더 넣어도 힙 순서가 유지되어야 함
+	if(type & BST_TREAP){
+		errors += _checkPriority(tree->root);
+		for(int i=0; i<numbers; i++) BST_Insert(tree, rand() % (numbers * 3) + 1);
+		errors += _checkPriority(tree->root);
+	}
+	BST_Destroy( tree);
+	
+	//정렬된 순서로 넣은 트리 (BST_PLAIN이면 한쪽으로만 뻗은 높이 N의 트리)
+	int height, rebalancedHeight;
+	double avgDepth;
+	tree = BST_Create( type);
+	assert( tree);
+	for(int i=0; i<numbers; i++) BST_Insert(tree, i + 1);
+	BST_Stats( tree, &height, &avgDepth);
+	BST_Rebalance( tree);
+	BST_Stats( tree, &rebalancedHeight, &avgDepth);
+	errors += _checkHeight(tree, numbers);
+	BST_Destroy( tree);
+	
+	fprintf( stdout, "%s%s %d: checked select, rank and range count of %d data, sorted inserts rebalanced from height %d to %d, %d errors\n",
+		(type & BST_TREAP) ? "Treap" : "BST", (type & BST_ARENA) ? " (arena)" : "", numbers, count,
+		height, rebalancedHeight, errors);
+	
+	free( walk);
+	free( less);
+	return errors;
+}
+
+/* internal function of run_check
+	compares the order statistics of the tree with walk (its count data in order)
+	less[key] is the number of data less than key (0 <= key <= maxKey + 1)
+	return	number of errors
+*/
+static int _checkOrder( TREE *pTree, const int *walk, int count, const int *less, int maxKey){
+	int errors = 0;
+	
+	for(int k=0; k<count; k++){
+		int *found = BST_Select(pTree, k);
+		if(found == NULL || *found != walk[k]) errors++;
+	}
+	if(BST_Select(pTree, -1) != NULL || BST_Select(pTree, count) != NULL) errors++;
+	
+	//트리에 없는 키와 범위 밖의 키도 확인
+	for(int key=0; key<=maxKey; key++){
+		if(BST_Rank(pTree, key) != less[key]) errors++;
+		if(BST_RangeCount(pTree, key, key) != less[key+1] - less[key]) errors++;
+	}
+	for(int i=0; i<count; i++){
+		int lo = rand() % (maxKey + 1);
+		int hi = rand() % (maxKey + 1);
+		int expected = (lo > hi) ? 0 : less[hi+1] - less[lo];
+		if(BST_RangeCount(pTree, lo, hi) != expected) errors++;
+	}
+	return errors;
+}
+
+/* internal function of run_check
+	return	number of nodes whose priority is lower than a child's (heap order of a treap)
+*/
+static int _checkPriority( NODE *root){
+	if(root == NULL) return 0;
+	
+	int errors = 0;
+	if(root->left != NULL && root->left->priority > root->priority) errors++;
+	if(root->right != NULL && root->right->priority > root->priority) errors++;
+	return errors + _checkPriority(root->left) + _checkPriority(root->right);
+}
+
+/* internal function of run_check
+	return	1 if the tree is not height-optimal for count nodes; 0 if it is
+*/
+static int _checkHeight( TREE *pTree, int count){
+	int height, optimal = 0;
+	double avgDepth;
+	
+	//count개의 노드를 담을 수 있는 가장 낮은 높이
+	while((1L << optimal) - 1 < count) optimal++;
+	BST_Stats( pTree, &height, &avgDepth);
+	return height != optimal;
+}
+
+/* internal function
+	return	number of nodes in the subtree (0 for NULL)
+*/
+static int _size( NODE *root){
+	return root == NULL ? 0 : root->size;
+}
+
+/* internal function
+	recomputes the size of node from its children
+*/
+static void _update( NODE *root){
+	root->size = _size(root->left) + _size(root->right) + 1;
+}
+
+/* Returns the k-th smallest data (k starts from 0)
+	return	address of data
+			NULL if k is out of range
+*/
+int *BST_Select( TREE *pTree, int k){
+	NODE *root = pTree->root;
+	
+	if(k < 0 || k >= _size(root)) return NULL;
+	while(1){
+		int left = _size(root->left);
+		if(k == left) return &root->data;
+		if(k < left) root = root->left;
+		else{
+			//왼쪽 서브트리와 자신을 건너뜀
+			k -= left + 1;
+			root = root->right;
+		}
+	}
+}
+
+/* Returns the number of data less than key
+	BST_Select( pTree, BST_Rank( pTree, key)) is the first data not less than key
+*/
+int BST_Rank( TREE *pTree, int key){
+	return _countLess(pTree->root, key, 0);
+}
+
+/* Returns the number of data in [lo, hi]
+*/
+int BST_RangeCount( TREE *pTree, int lo, int hi){
+	if(lo > hi) return 0;
+	return _countLess(pTree->root, hi, 1) - _countLess(pTree->root, lo, 0);
+}
+
+/* internal function
+	counts data less than key (orEqual 0) or not greater than key (orEqual 1)
+*/
+static int _countLess( NODE *root, int key, int orEqual){
+	int count = 0;
+	
+	//같은 키는 양쪽 서브트리에 있을 수 있으므로 비교 결과만 따라감
+	while(root != NULL){
+		if(root->data < key || (orEqual && root->data == key)){
+			count += _size(root->left) + 1;
+			root = root->right;
+		}
+		else root = root->left;
+	}
+	return count;
+}
+
+/* Builds a height-optimal tree from data sorted in ascending order in O(N)
+	all nodes are placed in one contiguous allocation in order (the first slab of a BST_ARENA tree)
+	type	BST_PLAIN or BST_TREAP
+	return	head node pointer
+			NULL if overflow
+*/
+TREE *BST_BuildFromSorted( int type, const int *data, int count){
+	TREE *ptr = BST_Create(type | BST_ARENA);
+	if(ptr == NULL) return NULL;
+	if(count <= 0) return ptr;
+	
+	//모든 노드를 담는 하나의 슬랩 (첫 노드 자리는 슬랩 리스트 연결)
+	NODE *slab = (NODE *)malloc(sizeof(NODE) * (count + 1));
+	if(slab == NULL){
+		free(ptr);
+		return NULL;
+	}
+	*(void **)slab = NULL;
+	ptr->slabs = slab;
+	
+	//순서대로 오른쪽 링크로 이어 _build에 넘김
+	NODE *block = slab + 1;
+	for(int i=0; i<count; i++){
+		block[i].data = data[i];
+		block[i].right = (i + 1 < count) ? &block[i + 1] : NULL;
+	}
+	ptr->root = _build(&block, count, 1);
+	return ptr;
+}
+
+static int _compareInt( const void *a, const void *b){
+	int x = *(const int *)a;
+	int y = *(const int *)b;
+	return (x > y) - (x < y);
+}
+
+/* Sorts a copy of data and builds a height-optimal tree with BST_BuildFromSorted
+	return	head node pointer
+			NULL if overflow
+*/
+TREE *BST_BuildFromUnsorted( int type, const int *data, int count){
+	if(count <= 0) return BST_Create(type);
+	
+	int *sorted = (int *)malloc(sizeof(int) * count);
+	if(sorted == NULL) return NULL;
+	memcpy(sorted, data, sizeof(int) * count);
+	qsort(sorted, count, sizeof(int), _compareInt);
+	
+	TREE *ptr = BST_BuildFromSorted(type, sorted, count);
+	free(sorted);
+	return ptr;
+}
+
+/* Rebuilds the tree into a height-optimal shape in O(N), reusing its nodes
+*/
+void BST_Rebalance( TREE *pTree){
+	NODE head;
+	NODE *tail = &head;
+	NODE *rest = pTree->root;
+	int count = _size(pTree->root);
+	
+	//오른쪽 회전을 반복해 오른쪽 링크로만 이어진 정렬 리스트로 폄 (추가 메모리 없음)
+	head.right = rest;
+	while(rest != NULL){
+		if(rest->left == NULL){
+			tail = rest;
+			rest = rest->right;
+		}
+		else{
+			NODE *temp = rest->left;
+			rest->left = temp->right;
+			temp->right = rest;
+			rest = temp;
+			tail->right = temp;
+		}
+	}
+	
+	NODE *list = head.right;
+	pTree->root = _build(&list, count, 1);
+}
+
+/* internal function
+	builds a height-optimal tree from the first count nodes of *list (linked by right in order)
+	and advances *list past them
+	index is the heap index of the subtree root (1 for the root); priorities decrease with it
+	return	pointer to root
+*/
+static NODE *_build( NODE **list, int count, unsigned long index){
+	if(count == 0) return NULL;
+	
+	//왼쪽 절반을 먼저 만들고 다음 노드를 루트로 씀 (재귀 깊이는 log N)
+	int leftCount = count / 2;
+	NODE *left = _build(list, leftCount, 2 * index);
+	NODE *root = *list;
+	*list = root->right;
+	root->left = left;
+	root->right = _build(list, count - leftCount - 1, 2 * index + 1);
+	root->size = count;
+	
+	//깊이 depth의 노드는 (UINT_MAX >> (depth+1), UINT_MAX >> depth] 구간의 우선순위를 가짐
+	//부모의 구간이 항상 자식보다 위이므로 힙 순서를 지키고,
+	//깊을수록 작은 우선순위가 되어 새 노드의 임의 우선순위가 전체 범위에서 섞임
+	int depth = 0;
+	while((index >> (depth + 1)) != 0) depth++;
+	unsigned int high = UINT_MAX >> depth;
+	unsigned int width = high - (UINT_MAX >> (depth + 1));
+	unsigned long pos = index - (1UL << depth);	// 같은 깊이에서의 순서
+	root->priority = high - (unsigned int)(((unsigned long long)width * pos) >> depth);
+	return root;
+}
@@ -0,0 +1,720 @@
+#include <stdlib.h> // malloc, atoi, rand
+#include <stdio.h>
+#include <string.h> // strcmp, memmove
+#include <assert.h>
+#include <time.h> // time, clock_gettime
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#define RANDOM_INPUT	1
+#define FILE_INPUT		2
+
+// node capacities chosen so that nodes fill whole cache lines
+#define LEAF_KEYS		28 // 128 bytes (2 lines)
+#define INNER_KEYS		15 // 192 bytes (3 lines)
+
+////////////////////////////////////////////////////////////////////////////////
+// TREE type definition
+// B+-tree with the same interface as intbst.c
+// all data is kept in leaves; inner keys only separate subtrees
+// keys in child[i] are between keys[i-1] and keys[i] (both inclusive, data may be duplicated)
+typedef struct leaf
+{
+	int			keys[LEAF_KEYS];
+	int			count;		// must follow keys (searched in blocks of 8 past the end)
+	struct leaf	*next;		// leaf on the right
+} LEAF;
+
+typedef struct inner
+{
+	int			keys[INNER_KEYS];
+	int			count;		// must follow keys (searched in blocks of 8 past the end)
+	void		*child[INNER_KEYS + 1];	// LEAF at level 1; INNER above
+} INNER;
+
+typedef struct
+{
+	void	*root;		// NULL if empty
+	int		height;		// number of inner levels (0: root is a leaf)
+	long	nodes;		// number of allocated nodes
+} TREE;
+
+////////////////////////////////////////////////////////////////////////////////
+// Prototype declarations
+
+/* Allocates dynamic memory for a tree head node and returns its address to caller
+	return	head node pointer
+			NULL if overflow
+*/
+TREE *BST_Create( void);
+
+/* Deletes all data in tree and recycles memory
+*/
+void BST_Destroy( TREE *pTree);
+
+/* internal function
+	level is 0 for a leaf
+*/
+static void _destroy( void *node, int level);
+
+/* Inserts new data into the tree
+	return	1 success
+			0 overflow
+*/
+int BST_Insert( TREE *pTree, int data);
+
+/* internal function
+	inserts data after the equal ones in the subtree
+	if the node is split, *upNode is the new right node and *upKey its separator; NULL if not
+	return	1 success
+			0 overflow
+*/
+static int _insert( TREE *pTree, void *node, int level, int data, int *upKey, void **upNode);
+
+/* Deletes a node with dltKey from the tree
+	return	1 success
+			0 not found
+*/
+int BST_Delete( TREE *pTree, int dltKey);
+
+/* internal function
+	deletes one data equal to dltKey in the subtree; the node may underflow
+	return	1 success
+			0 not found
+*/
+static int _delete( TREE *pTree, void *node, int level, int dltKey);
+
+/* internal function
+	refills child[i] of parent by borrowing from or merging with a sibling
+	level is the level of the child
+*/
+static void _fix( TREE *pTree, INNER *parent, int i, int level);
+
+/* internal function
+	removes keys[i] and child[i + 1] from the node
+*/
+static void _removeAt( INNER *inner, int i);
+
+/* Retrieve tree for the node containing the requested key
+	return	address of data of the node containing the key
+			NULL not found
+*/
+int *BST_Retrieve( TREE *pTree, int key);
+
+/* internal function
+	counts keys less than key (upper 0) or not greater than key (upper 1)
+	keys must be sorted
+*/
+static int _rank( const int *keys, int count, int key, int upper);
+
+/* Computes the height and the average depth of data (root depth is 0)
+	all data is in leaves, so the average depth is the number of inner levels
+*/
+void BST_Stats( TREE *pTree, int *height, double *avgDepth);
+
+/* prints tree using inorder traversal
+*/
+void BST_Traverse( TREE *pTree);
+
+/* Print tree using inorder right-to-left traversal
+	a leaf is printed in one line
+*/
+void printTree( TREE *pTree);
+
+/* internal traversal function
+*/
+static void _inorder_print( void *node, int level, int depth);
+
+/*
+	return 1 if the tree is empty; 0 if not
+*/
+int BST_Empty( TREE *pTree);
+
+/* Allocates an empty node (64-byte aligned)
+	return	node pointer
+			NULL if overflow
+*/
+static LEAF *_makeLeaf( TREE *pTree);
+static INNER *_makeInner( TREE *pTree);
+
+/* Recycles memory of a node
+*/
+static void _freeNode( TREE *pTree, void *node);
+
+/* Times insert, retrieve and delete of numbers random data
+*/
+void run_bench( int numbers);
+
+double get_time( void);
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int mode; // input mode
+	TREE *tree;
+	int data;
+
+	// benchmark
+	if (argc == 3 && strcmp( argv[1], "-b") == 0)
+	{
+		run_bench( atoi( argv[2]));
+		return 0;
+	}
+
+	if (argc != 2)
+	{
+		fprintf( stderr, "usage: %s FILE or %s [-b] number\n", argv[0], argv[0]);
+		return 1;
+	}
+
+	FILE *fp;
+
+	if ((fp = fopen(argv[1], "rt")) == NULL)
+	{
+		mode = RANDOM_INPUT;
+	}
+	else mode = FILE_INPUT;
+
+	// creates a null tree
+	tree = BST_Create();
+
+	if (!tree)
+	{
+		printf( "Cannot create a tree!\n");
+		return 100;
+	}
+
+	if (mode == RANDOM_INPUT)
+	{
+		int numbers;
+		numbers = atoi(argv[1]);
+		assert( numbers > 0);
+
+		fprintf( stdout, "Inserting: ");
+
+		srand( time(NULL));
+		for (int i = 0; i < numbers; i++)
+		{
+			data = rand() % (numbers*3) + 1; // random number (1 ~ numbers * 3)
+
+			fprintf( stdout, "%d ", data);
+
+			// insert function call
+			int ret = BST_Insert( tree, data);
+			if (!ret) break;
+		}
+	}
+	else if (mode == FILE_INPUT)
+	{
+		fprintf( stdout, "Inserting: ");
+
+		while (fscanf( fp, "%d", &data) != EOF)
+		{
+			fprintf( stdout, "%d ", data);
+
+			// insert function call
+			int ret = BST_Insert( tree, data);
+			if (!ret) break;
+		}
+		fclose( fp);
+	}
+
+	fprintf( stdout, "\n");
+
+	// shape of the tree
+	int height;
+	double avgDepth;
+	BST_Stats( tree, &height, &avgDepth);
+	fprintf( stderr, "Height: %d, average depth: %.2f\n", height, avgDepth);
+
+	if (BST_Empty( tree))
+	{
+		fprintf( stdout, "Empty tree!\n");
+		BST_Destroy( tree);
+		return 0;
+	}
+
+	// inorder traversal
+	fprintf( stdout, "Inorder traversal: ");
+	BST_Traverse( tree);
+	fprintf( stdout, "\n");
+
+	// print tree with right-to-left inorder traversal
+	fprintf( stdout, "Tree representation:\n");
+	printTree(tree);
+
+	while (1)
+	{
+		fprintf( stdout, "Input a number to delete: ");
+		int num;
+		if (scanf( "%d", &num) == EOF) break;
+
+		int ret = BST_Delete( tree, num);
+		if (!ret)
+		{
+			fprintf( stdout, "%d not found\n", num);
+			continue;
+		}
+
+		// print tree with right-to-left inorder traversal
+		fprintf( stdout, "Tree representation:\n");
+		printTree(tree);
+
+		if (BST_Empty( tree))
+		{
+			fprintf( stdout, "Empty tree!\n");
+			break;
+		}
+	}
+
+	BST_Destroy( tree);
+
+	return 0;
+}
+
+TREE *BST_Create( void){
+	TREE *ptr = (TREE *)malloc(sizeof(TREE));
+	if(ptr == NULL) return NULL;
+	ptr->root = NULL;
+	ptr->height = 0;
+	ptr->nodes = 0;
+	return ptr;
+}
+
+void BST_Destroy( TREE *pTree){
+	if(pTree->root != NULL) _destroy(pTree->root, pTree->height);
+	free(pTree);
+}
+
+static void _destroy( void *node, int level){
+	if(level > 0){
+		INNER *inner = (INNER *)node;
+		for(int i=0; i<=inner->count; i++) _destroy(inner->child[i], level - 1);
+	}
+	free(node);
+}
+
+static LEAF *_makeLeaf( TREE *pTree){
+	LEAF *ptr = (LEAF *)aligned_alloc(64, sizeof(LEAF));
+	if(ptr == NULL) return NULL;
+	ptr->count = 0;
+	ptr->next = NULL;
+	pTree->nodes++;
+	return ptr;
+}
+
+static INNER *_makeInner( TREE *pTree){
+	INNER *ptr = (INNER *)aligned_alloc(64, sizeof(INNER));
+	if(ptr == NULL) return NULL;
+	ptr->count = 0;
+	pTree->nodes++;
+	return ptr;
+}
+
+static void _freeNode( TREE *pTree, void *node){
+	free(node);
+	pTree->nodes--;
+}
+
+/* internal function
+	counts keys less than key (upper 0) or not greater than key (upper 1)
+	keys must be sorted
+*/
+static int _rank( const int *keys, int count, int key, int upper){
+	int rank = 0;
+
+#if defined(__AVX2__)
+	//8개씩 비교 (노드 끝을 넘는 부분은 같은 노드 안이고 마스크로 버림)
+	__m256i k = _mm256_set1_epi32(key);
+	for(int i=0; i<count; i+=8){
+		__m256i v = _mm256_loadu_si256((const __m256i *)(keys + i));
+		__m256i c = upper ? _mm256_cmpgt_epi32(v, k) : _mm256_cmpgt_epi32(k, v);
+		unsigned int bits = _mm256_movemask_ps(_mm256_castsi256_ps(c));
+		if(upper) bits = ~bits & 0xFF;
+		if(count - i < 8) bits &= (1u << (count - i)) - 1;
+		rank += __builtin_popcount(bits);
+	}
+#elif defined(__SSE2__)
+	//4개씩 비교
+	__m128i k = _mm_set1_epi32(key);
+	for(int i=0; i<count; i+=4){
+		__m128i v = _mm_loadu_si128((const __m128i *)(keys + i));
+		__m128i c = upper ? _mm_cmpgt_epi32(v, k) : _mm_cmpgt_epi32(k, v);
+		unsigned int bits = _mm_movemask_ps(_mm_castsi128_ps(c));
+		if(upper) bits = ~bits & 0xF;
+		if(count - i < 4) bits &= (1u << (count - i)) - 1;
+		rank += __builtin_popcount(bits);
+	}
+#else
+	for(int i=0; i<count; i++){
+		if(keys[i] < key || (upper && keys[i] == key)) rank++;
+	}
+#endif
+	return rank;
+}
+
+int BST_Insert( TREE *pTree, int data){
+	int upKey;
+	void *upNode;
+	INNER *newRoot = NULL;
+
+	if(pTree->root == NULL){
+		LEAF *leaf = _makeLeaf(pTree);
+		if(leaf == NULL) return 0;
+		leaf->keys[0] = data;
+		leaf->count = 1;
+		pTree->root = leaf;
+		return 1;
+	}
+
+	//루트가 나뉠 수 있으면 새 루트를 미리 확보
+	if(pTree->height == 0 ? ((LEAF *)pTree->root)->count == LEAF_KEYS : ((INNER *)pTree->root)->count == INNER_KEYS){
+		newRoot = _makeInner(pTree);
+		if(newRoot == NULL) return 0;
+	}
+	if(!_insert(pTree, pTree->root, pTree->height, data, &upKey, &upNode)){
+		if(newRoot != NULL) _freeNode(pTree, newRoot);
+		return 0;
+	}
+
+	if(upNode != NULL){
+		newRoot->keys[0] = upKey;
+		newRoot->child[0] = pTree->root;
+		newRoot->child[1] = upNode;
+		newRoot->count = 1;
+		pTree->root = newRoot;
+		pTree->height++;
+	}
+	else if(newRoot != NULL) _freeNode(pTree, newRoot);
+	return 1;
+}
+
+static int _insert( TREE *pTree, void *node, int level, int data, int *upKey, void **upNode){
+	*upNode = NULL;
+
+	if(level == 0){
+		LEAF *leaf = (LEAF *)node;
+		int pos = _rank(leaf->keys, leaf->count, data, 1);
+
+		if(leaf->count == LEAF_KEYS){
+			//반으로 나누고 오른쪽 노드를 부모에 올림
+			LEAF *right = _makeLeaf(pTree);
+			if(right == NULL) return 0;
+			int half = LEAF_KEYS / 2;
+			memcpy(right->keys, leaf->keys + half, sizeof(int) * (LEAF_KEYS - half));
+			right->count = LEAF_KEYS - half;
+			leaf->count = half;
+			right->next = leaf->next;
+			leaf->next = right;
+			if(pos > half){
+				leaf = right;
+				pos -= half;
+			}
+			*upNode = right;
+		}
+		memmove(leaf->keys + pos + 1, leaf->keys + pos, sizeof(int) * (leaf->count - pos));
+		leaf->keys[pos] = data;
+		leaf->count++;
+		if(*upNode != NULL) *upKey = ((LEAF *)*upNode)->keys[0];
+		return 1;
+	}
+
+	INNER *inner = (INNER *)node;
+	INNER *right = NULL;
+	int i = _rank(inner->keys, inner->count, data, 1);
+	int key;
+	void *child;
+
+	//자식이 나뉘어도 잃지 않도록 나눌 노드를 미리 확보
+	if(inner->count == INNER_KEYS){
+		right = _makeInner(pTree);
+		if(right == NULL) return 0;
+	}
+	if(!_insert(pTree, inner->child[i], level - 1, data, &key, &child)){
+		if(right != NULL) _freeNode(pTree, right);
+		return 0;
+	}
+	if(child == NULL){
+		if(right != NULL) _freeNode(pTree, right);
+		return 1;
+	}
+
+	if(inner->count < INNER_KEYS){
+		memmove(inner->keys + i + 1, inner->keys + i, sizeof(int) * (inner->count - i));
+		memmove(inner->child + i + 2, inner->child + i + 1, sizeof(void *) * (inner->count - i));
+		inner->keys[i] = key;
+		inner->child[i + 1] = child;
+		inner->count++;
+		return 1;
+	}
+
+	//가득 찬 노드는 임시 배열에 합친 뒤 가운데 키를 올림
+	int keys[INNER_KEYS + 1];
+	void *children[INNER_KEYS + 2];
+	memcpy(keys, inner->keys, sizeof(int) * i);
+	keys[i] = key;
+	memcpy(keys + i + 1, inner->keys + i, sizeof(int) * (INNER_KEYS - i));
+	memcpy(children, inner->child, sizeof(void *) * (i + 1));
+	children[i + 1] = child;
+	memcpy(children + i + 2, inner->child + i + 1, sizeof(void *) * (INNER_KEYS - i));
+
+	int half = (INNER_KEYS + 1) / 2;
+	memcpy(inner->keys, keys, sizeof(int) * half);
+	memcpy(inner->child, children, sizeof(void *) * (half + 1));
+	inner->count = half;
+	memcpy(right->keys, keys + half + 1, sizeof(int) * (INNER_KEYS - half));
+	memcpy(right->child, children + half + 1, sizeof(void *) * (INNER_KEYS - half + 1));
+	right->count = INNER_KEYS - half;
+
+	*upKey = keys[half];
+	*upNode = right;
+	return 1;
+}
+
+int BST_Delete( TREE *pTree, int dltKey){
+	if(pTree->root == NULL) return 0;
+	if(!_delete(pTree, pTree->root, pTree->height, dltKey)) return 0;
+
+	//빈 루트를 없애 높이를 줄임
+	if(pTree->height > 0 && ((INNER *)pTree->root)->count == 0){
+		void *child = ((INNER *)pTree->root)->child[0];
+		_freeNode(pTree, pTree->root);
+		pTree->root = child;
+		pTree->height--;
+	}
+	else if(pTree->height == 0 && ((LEAF *)pTree->root)->count == 0){
+		_freeNode(pTree, pTree->root);
+		pTree->root = NULL;
+	}
+	return 1;
+}
+
+static int _delete( TREE *pTree, void *node, int level, int dltKey){
+	if(level == 0){
+		LEAF *leaf = (LEAF *)node;
+		int pos = _rank(leaf->keys, leaf->count, dltKey, 0);
+		if(pos == leaf->count || leaf->keys[pos] != dltKey) return 0;
+		leaf->count--;
+		memmove(leaf->keys + pos, leaf->keys + pos + 1, sizeof(int) * (leaf->count - pos));
+		return 1;
+	}
+
+	INNER *inner = (INNER *)node;
+	int i = _rank(inner->keys, inner->count, dltKey, 0);
+
+	//같은 데이터가 구분 키 오른쪽 서브트리에서 시작할 수 있음
+	while(1){
+		if(_delete(pTree, inner->child[i], level - 1, dltKey)){
+			_fix(pTree, inner, i, level - 1);
+			return 1;
+		}
+		if(i == inner->count || inner->keys[i] != dltKey) return 0;
+		i++;
+	}
+}
+
+/* internal function
+	removes keys[i] and child[i + 1] from the node
+*/
+static void _removeAt( INNER *inner, int i){
+	inner->count--;
+	memmove(inner->keys + i, inner->keys + i + 1, sizeof(int) * (inner->count - i));
+	memmove(inner->child + i + 1, inner->child + i + 2, sizeof(void *) * (inner->count - i));
+}
+
+static void _fix( TREE *pTree, INNER *parent, int i, int level){
+	if(level == 0){
+		LEAF *leaf = (LEAF *)parent->child[i];
+		LEAF *left = i > 0 ? (LEAF *)parent->child[i - 1] : NULL;
+		LEAF *right = i < parent->count ? (LEAF *)parent->child[i + 1] : NULL;
+
+		if(leaf->count >= LEAF_KEYS / 2) return;
+
+		if(left != NULL && left->count > LEAF_KEYS / 2){
+			//왼쪽 형제의 마지막 데이터를 가져옴
+			memmove(leaf->keys + 1, leaf->keys, sizeof(int) * leaf->count);
+			leaf->keys[0] = left->keys[--left->count];
+			leaf->count++;
+			parent->keys[i - 1] = leaf->keys[0];
+		}
+		else if(right != NULL && right->count > LEAF_KEYS / 2){
+			//오른쪽 형제의 첫 데이터를 가져옴
+			leaf->keys[leaf->count++] = right->keys[0];
+			right->count--;
+			memmove(right->keys, right->keys + 1, sizeof(int) * right->count);
+			parent->keys[i] = right->keys[0];
+		}
+		else{
+			//형제와 합침
+			if(left == NULL){
+				left = leaf;
+				leaf = right;
+				i++;
+			}
+			memcpy(left->keys + left->count, leaf->keys, sizeof(int) * leaf->count);
+			left->count += leaf->count;
+			left->next = leaf->next;
+			_freeNode(pTree, leaf);
+			_removeAt(parent, i - 1);
+		}
+		return;
+	}
+
+	INNER *inner = (INNER *)parent->child[i];
+	INNER *left = i > 0 ? (INNER *)parent->child[i - 1] : NULL;
+	INNER *right = i < parent->count ? (INNER *)parent->child[i + 1] : NULL;
+
+	if(inner->count >= INNER_KEYS / 2) return;
+
+	if(left != NULL && left->count > INNER_KEYS / 2){
+		//부모의 구분 키를 통해 왼쪽으로 회전
+		memmove(inner->keys + 1, inner->keys, sizeof(int) * inner->count);
+		memmove(inner->child + 1, inner->child, sizeof(void *) * (inner->count + 1));
+		inner->keys[0] = parent->keys[i - 1];
+		inner->child[0] = left->child[left->count];
+		inner->count++;
+		parent->keys[i - 1] = left->keys[--left->count];
+	}
+	else if(right != NULL && right->count > INNER_KEYS / 2){
+		//부모의 구분 키를 통해 오른쪽에서 회전
+		inner->keys[inner->count] = parent->keys[i];
+		inner->child[inner->count + 1] = right->child[0];
+		inner->count++;
+		parent->keys[i] = right->keys[0];
+		right->count--;
+		memmove(right->keys, right->keys + 1, sizeof(int) * right->count);
+		memmove(right->child, right->child + 1, sizeof(void *) * (right->count + 1));
+	}
+	else{
+		//구분 키를 내려 형제와 합침
+		if(left == NULL){
+			left = inner;
+			inner = right;
+			i++;
+		}
+		left->keys[left->count] = parent->keys[i - 1];
+		memcpy(left->keys + left->count + 1, inner->keys, sizeof(int) * inner->count);
+		memcpy(left->child + left->count + 1, inner->child, sizeof(void *) * (inner->count + 1));
+		left->count += inner->count + 1;
+		_freeNode(pTree, inner);
+		_removeAt(parent, i - 1);
+	}
+}
+
+int *BST_Retrieve( TREE *pTree, int key){
+	void *node = pTree->root;
+	if(node == NULL) return NULL;
+
+	for(int level = pTree->height; level > 0; level--){
+		INNER *inner = (INNER *)node;
+		node = inner->child[_rank(inner->keys, inner->count, key, 0)];
+	}
+
+	LEAF *leaf = (LEAF *)node;
+	int pos = _rank(leaf->keys, leaf->count, key, 0);
+	//처음 같은 데이터가 다음 잎에 있을 수 있음
+	if(pos == leaf->count){
+		leaf = leaf->next;
+		pos = 0;
+	}
+	if(leaf == NULL || leaf->keys[pos] != key) return NULL;
+	return &leaf->keys[pos];
+}
+
+void BST_Stats( TREE *pTree, int *height, double *avgDepth){
+	*height = pTree->root == NULL ? 0 : pTree->height + 1;
+	*avgDepth = pTree->root == NULL ? 0 : pTree->height;
+}
+
+void BST_Traverse( TREE *pTree){
+	void *node = pTree->root;
+	if(node == NULL) return;
+
+	//가장 왼쪽 잎부터 연결을 따라감
+	for(int level = pTree->height; level > 0; level--) node = ((INNER *)node)->child[0];
+	for(LEAF *leaf = (LEAF *)node; leaf != NULL; leaf = leaf->next){
+		for(int i=0; i<leaf->count; i++) printf(" %d", leaf->keys[i]);
+	}
+}
+
+void printTree( TREE *pTree){
+	if(pTree->root == NULL) return;
+	_inorder_print(pTree->root, pTree->height, 0);
+}
+
+static void _inorder_print( void *node, int level, int depth){
+	if(level == 0){
+		LEAF *leaf = (LEAF *)node;
+		for(int i=0; i<depth; i++) printf("\t");
+		printf("[");
+		for(int i=0; i<leaf->count; i++) printf(i ? " %d" : "%d", leaf->keys[i]);
+		printf("]\n");
+		return;
+	}
+
+	INNER *inner = (INNER *)node;
+	for(int i=inner->count; i>=0; i--){
+		_inorder_print(inner->child[i], level - 1, depth + 1);
+		if(i > 0){
+			for(int j=0; j<depth; j++) printf("\t");
+			printf("%d\n", inner->keys[i - 1]);
+		}
+	}
+}
+
+int BST_Empty( TREE *pTree){
+	if(pTree->root == NULL) return 1;
+	else return 0;
+}
+
+double get_time( void){
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Times insert, retrieve and delete of numbers random data
+*/
+void run_bench( int numbers){
+	TREE *tree = BST_Create();
+	int *data = (int *)malloc(sizeof(int) * numbers);
+	long found = 0;
+	assert( numbers > 0 && tree && data);
+
+	srand(1);
+	for(int i=0; i<numbers; i++) data[i] = rand();
+
+	double start_time = get_time();
+	for(int i=0; i<numbers; i++) BST_Insert(tree, data[i]);
+	double insert_time = get_time() - start_time;
+
+	//메모리는 잎과 안쪽 노드를 따로 셈
+	void *node = tree->root;
+	long leaves = 0;
+	for(int level = tree->height; level > 0; level--) node = ((INNER *)node)->child[0];
+	for(LEAF *leaf = (LEAF *)node; leaf != NULL; leaf = leaf->next) leaves++;
+	double bytes = (double)(leaves * sizeof(LEAF) + (tree->nodes - leaves) * sizeof(INNER)) / numbers;
+
+	//섞은 순서로 찾고 지움
+	for(int i=numbers-1; i>0; i--){
+		int j = rand() % (i + 1);
+		int temp = data[i];
+		data[i] = data[j];
+		data[j] = temp;
+	}
+	start_time = get_time();
+	for(int i=0; i<numbers; i++) found += BST_Retrieve(tree, data[i]) != NULL;
+	double retrieve_time = get_time() - start_time;
+
+	start_time = get_time();
+	for(int i=0; i<numbers; i++) BST_Delete(tree, data[i]);
+	double delete_time = get_time() - start_time;
+
+	fprintf( stdout, "B+-tree %d: insert %.1f ns, retrieve %.1f ns, delete %.1f ns per op, %.1f bytes per data (%ld found)\n",
+		numbers, insert_time * 1e9 / numbers, retrieve_time * 1e9 / numbers, delete_time * 1e9 / numbers, bytes, found);
+
+	BST_Destroy( tree);
+	free( data);
+}
@@ -1,63 +1,123 @@
 #include <stdio.h>
-#include <stdlib.h> // malloc, realloc
+#include <stdlib.h> // malloc, aligned_alloc
+#include <string.h> // memcpy
 
 #include "adt_heap.h"
 
+/* Compares two entries by their key prefixes, then by compare if the prefixes are equal
+*/
+static inline int _compareEntry( HEAP *heap, HEAP_ENTRY *a, HEAP_ENTRY *b){
+	if(a->key != b->key) return (a->key < b->key) ? -1 : 1;
+	if(heap->compare == NULL) return 0;
+	return heap->compare(a->dataPtr, b->dataPtr);
+}
+
 /* Reestablishes heap by moving data in child up to correct location heap array
+moves the hole up instead of swapping and writes the data once
 */
 static void _reheapUp( HEAP *heap, int index){
-	if(index == 0) return;
-	if(heap->compare(*(heap->heapArr+((index-1)/2)), *(heap->heapArr+index)) < 0){
-		void *temp = *(heap->heapArr+index);
-		*(heap->heapArr+index) = *(heap->heapArr+((index-1)/2));
-		*(heap->heapArr+((index-1)/2)) = temp;
-		_reheapUp(heap, (index-1)/2);
+	HEAP_ENTRY data = heap->heapArr[index];
+	
+	while(index > 0){
+		int parent = (index - 1) / heap->arity;
+		if(_compareEntry(heap, &heap->heapArr[parent], &data) >= 0) break;
+		heap->heapArr[index] = heap->heapArr[parent];
+		index = parent;
 	}
+	heap->heapArr[index] = data;
 }
 
 
 /* Reestablishes heap by moving data in root down to its correct location in the heap
+moves the hole down to the largest child instead of swapping and writes the data once
 */
 static void _reheapDown( HEAP *heap, int index){
-	int nextIdx;
-	void *largest;
-	if(index*2+1 <= heap->last){
-		void *left = *(heap->heapArr+(index*2+1));
-		nextIdx = index*2+1;
-		largest = left;
-		if(index*2+2 <= heap->last){		
-			void *right = *(heap->heapArr+(index*2+2));
-			if(heap->compare(left, right) < 0){
-				nextIdx = index*2+2;
-				largest = right;
-			}
-		}
-		if(heap->compare(largest, *(heap->heapArr+index)) > 0){
-			*(heap->heapArr+nextIdx) = *(heap->heapArr+index);
-			*(heap->heapArr+index) = largest;
-			_reheapDown(heap, nextIdx);
+	HEAP_ENTRY data = heap->heapArr[index];
+	int arity = heap->arity;
+	
+	while(1){
+		int first = index * arity + 1;
+		if(first > heap->last) break;
+		
+		//자식 그룹(한 캐시 라인) 중 가장 큰 것을 찾음 (같으면 앞쪽)
+		int end = first + arity - 1;
+		if(end > heap->last) end = heap->last;
+		int nextIdx = first;
+		for(int i=first+1; i<=end; i++){
+			if(_compareEntry(heap, &heap->heapArr[nextIdx], &heap->heapArr[i]) < 0) nextIdx = i;
 		}
+		
+		if(_compareEntry(heap, &heap->heapArr[nextIdx], &data) <= 0) break;
+		heap->heapArr[index] = heap->heapArr[nextIdx];
+		index = nextIdx;
 	}
-}	
+	heap->heapArr[index] = data;
+}
+
+/* Allocates an aligned array for capacity data and copies the current data into it
+heapArr is shifted by arity-1 slots so that every group of children starts on a line boundary
+return 1 if successful; 0 if memory overflow
+*/
+static int _resize( HEAP *heap, int capacity){
+	size_t size = sizeof(HEAP_ENTRY) * (capacity + heap->arity - 1);
+	size = (size + HEAP_LINE - 1) / HEAP_LINE * HEAP_LINE;
+	
+	void *mem = aligned_alloc(HEAP_LINE, size);
+	if(mem == NULL) return 0;
+	
+	HEAP_ENTRY *arr = (HEAP_ENTRY *)mem + heap->arity - 1;
+	if(heap->heapArr != NULL) memcpy(arr, heap->heapArr, sizeof(HEAP_ENTRY) * (heap->last + 1));
+	free(heap->heapMem);
+	heap->heapMem = mem;
+	heap->heapArr = arr;
+	heap->capacity = capacity;
+	return 1;
+}
 
 /* Allocates memory for heap and returns address of heap head structure
 if memory overflow, NULL returned
 */
 HEAP *heap_Create( int capacity, int (*compare) (void *arg1, void *arg2)){
+	return heap_CreateEx(capacity, compare, 2);
+}
+
+/* Allocates memory for a d-ary heap (arity 2, 4 or 8)
+if memory overflow or arity is not supported, NULL returned
+*/
+HEAP *heap_CreateEx( int capacity, int (*compare) (void *arg1, void *arg2), int arity){
+	return heap_CreateKey(capacity, compare, NULL, arity);
+}
+
+/* Allocates memory for a d-ary heap whose entries cache a key prefix of data
+compare is called only when prefixes are equal (never if compare is NULL)
+if memory overflow or arity is not supported, NULL returned
+*/
+HEAP *heap_CreateKey( int capacity, int (*compare) (void *arg1, void *arg2), unsigned long long (*keyOf) (const void *dataPtr), int arity){
+	if(arity != 2 && arity != 4 && arity != 8) return NULL;
+	if(capacity < 1) capacity = 1;
+	
 	HEAP *ptr = (HEAP *)malloc(sizeof(HEAP));
+	if(ptr == NULL) return NULL;
 	ptr->compare = compare;
-	ptr->capacity = capacity;
+	ptr->keyOf = keyOf;
+	ptr->arity = arity;
 	ptr->last = -1;
-	ptr->heapArr = malloc(sizeof(void *) * capacity);
+	ptr->heapArr = NULL;
+	ptr->heapMem = NULL;
+	if(!_resize(ptr, capacity)){
+		free(ptr);
+		return NULL;
+	}
+	return ptr;
 }
 
 /* Free memory for heap
 */
 void heap_Destroy( HEAP *heap){
 	for(int i=0; i<=heap->last; i++){
-		free(*(heap->heapArr+i));
+		free(heap->heapArr[i].dataPtr);
 	}
-	free(heap->heapArr);
+	free(heap->heapMem);
 	heap->capacity = 0;
 	heap->last = 0;
 	free(heap);
@@ -68,13 +128,11 @@ return 1 if successful; 0 if heap full
 */
 int heap_Insert( HEAP *heap, void *dataPtr){
 	if(heap->last+1 == heap->capacity) {
-		if(heap->heapArr = (void *)realloc(heap->heapArr, sizeof(void *) * heap->capacity * 2)){
-			heap->capacity *= 2;
-		}
-		else return 0;
+		if(!_resize(heap, heap->capacity * 2)) return 0;
 	}
 	heap->last++;
-	*(heap->heapArr+heap->last) = dataPtr;	
+	heap->heapArr[heap->last].key = (heap->keyOf != NULL) ? heap->keyOf(dataPtr) : 0;
+	heap->heapArr[heap->last].dataPtr = dataPtr;
 	_reheapUp(heap, heap->last);
 	return 1;
 }
@@ -84,8 +142,8 @@ return 1 if successful; 0 if heap empty
 */
 int heap_Delete( HEAP *heap, void **dataOutPtr){
 	if(heap_Empty(heap) == 1) return 0;
-	*dataOutPtr = *heap->heapArr;
-	*(heap->heapArr) = *(heap->heapArr+heap->last);
+	*dataOutPtr = heap->heapArr[0].dataPtr;
+	heap->heapArr[0] = heap->heapArr[heap->last];
 	heap->last--;
 	_reheapDown(heap, 0);
 	return 1;
@@ -102,7 +160,7 @@ int heap_Empty(  HEAP *heap){
 /* Print heap array */
 void heap_Print( HEAP *heap, void (*print_func) (void *data)){
 	for(int i=0; i<=heap->last; i++){
-		print_func(*(heap->heapArr+i));
+		print_func(heap->heapArr[i].dataPtr);
 	}
 	printf("\n");
 }
\ No newline at end of file
@@ -1,15 +1,67 @@
+#define HEAP_LINE	64 // cache line size in bytes
+
+// heap entry: data with its key prefix kept inline, so most compares stay in the array
+typedef struct
+{
+	unsigned long long key;	// keyOf(dataPtr); 0 if the heap has no keyOf
+	void	*dataPtr;
+} HEAP_ENTRY;
+
 typedef struct
 {
-	void **heapArr;
+	HEAP_ENTRY *heapArr;
 	int	last;
 	int	capacity;
-	int (*compare) (void *arg1, void *arg2);
+	int (*compare) (void *arg1, void *arg2);	// called only when keys are equal; NULL if equal keys mean equal data
+	unsigned long long (*keyOf) (const void *dataPtr);	// NULL if not cached
+	int	arity;		// children per node (2, 4 or 8)
+	void *heapMem;	// aligned block holding heapArr (heapArr is shifted so child groups start on a line)
 } HEAP;
 
+////////////////////////////////////////////////////////////////////////////////
+// key prefix functions for heap_CreateKey
+// prefixes compare as unsigned integers in the same order as the data
+
+/* defines unsigned long long NAME(const void *) for data pointing to an integer TYPE
+	the prefix is the whole key, so compare may be NULL
+*/
+#define HEAP_INT_KEY(NAME, TYPE) \
+static unsigned long long NAME( const void *dataPtr) \
+{ \
+	return (unsigned long long)(long long)*(const TYPE *)dataPtr ^ 0x8000000000000000ULL; \
+}
+
+/* defines unsigned long long NAME(const void *) for data that is a string ordered by strcmp
+	packs the first 8 bytes big-endian; compare breaks ties of longer strings
+*/
+#define HEAP_STR_KEY(NAME) \
+static unsigned long long NAME( const void *dataPtr) \
+{ \
+	const unsigned char *s = (const unsigned char *)dataPtr; \
+	unsigned long long key = 0; \
+	for (int i = 0; i < 8 && s[i]; i++) key |= (unsigned long long)s[i] << (56 - 8 * i); \
+	return key; \
+}
+
 /* Allocates memory for heap and returns address of heap head structure
 if memory overflow, NULL returned
 */
 HEAP *heap_Create( int capacity, int (*compare) (void *arg1, void *arg2));
+
+/* Allocates memory for a d-ary heap (arity 2, 4 or 8)
+children of index i are arity*i+1 .. arity*i+arity and each group starts on a cache line
+(4-ary: one line per group of children; fewer levels for large heaps)
+if memory overflow or arity is not supported, NULL returned
+*/
+HEAP *heap_CreateEx( int capacity, int (*compare) (void *arg1, void *arg2), int arity);
+
+/* Allocates memory for a d-ary heap whose entries cache a key prefix of data
+keyOf returns an order-preserving 64-bit prefix (see HEAP_INT_KEY, HEAP_STR_KEY):
+keyOf(a) < keyOf(b) must imply compare(a, b) < 0
+compare is called only when prefixes are equal (never if compare is NULL)
+if memory overflow or arity is not supported, NULL returned
+*/
+HEAP *heap_CreateKey( int capacity, int (*compare) (void *arg1, void *arg2), unsigned long long (*keyOf) (const void *dataPtr), int arity);
 /* Free memory for heap
 */
 void heap_Destroy( HEAP *heap);
@@ -0,0 +1,147 @@
+#include <stdio.h>
+#include <string.h> // strdup, strcmp
+#include <stdlib.h> // malloc, rand, atoi
+#include <time.h> // clock_gettime
+#include "adt_heap.h"
+
+#define NUMBERS		2000000 // default number of strings
+#define INT_NUMBERS	4000000 // default number of ints
+
+/* user-defined compare function */
+int compare(void *arg1, void *arg2)
+{
+	return strcmp((char *)arg1, (char *)arg2);
+}
+
+/* key prefix of a string (first 8 bytes) */
+HEAP_STR_KEY( keyStr)
+
+/* compare function for int data */
+int compare_int(void *arg1, void *arg2)
+{
+	int x = *(int *)arg1;
+	int y = *(int *)arg2;
+	return (x > y) - (x < y);
+}
+
+double get_time( void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* inserts all strings, then times popping them all
+	return	pops per second
+			0 if the pops are not in order (the heap keeps the largest at the root)
+*/
+double bench( HEAP *heap, char **strs, int numbers)
+{
+	char *prev = NULL;
+	char *dataPtr;
+
+	for (int i = 0; i < numbers; i++) heap_Insert( heap, strs[i]);
+
+	double start_time = get_time();
+	for (int i = 0; i < numbers; i++)
+	{
+		heap_Delete( heap, (void **)&dataPtr);
+		if (prev && strcmp( dataPtr, prev) > 0) return 0;
+		prev = dataPtr;
+	}
+	double pop_time = get_time() - start_time;
+
+	// strings are shared by the runs and freed by main
+	heap_Destroy( heap);
+	return numbers / pop_time;
+}
+
+/* times inserting all ints and then deleting them all
+	return	seconds
+			0 if the deletes are not in order
+*/
+double bench_int( HEAP *heap, int *data, int numbers)
+{
+	int prev = 0;
+	int *dataPtr;
+
+	double start_time = get_time();
+	for (int i = 0; i < numbers; i++) heap_Insert( heap, &data[i]);
+	for (int i = 0; i < numbers; i++)
+	{
+		heap_Delete( heap, (void **)&dataPtr);
+		if (i > 0 && *dataPtr > prev) return 0;
+		prev = *dataPtr;
+	}
+	double total_time = get_time() - start_time;
+
+	// data is an array owned by main
+	heap_Destroy( heap);
+	return total_time;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int main( int argc, char **argv)
+{
+	int numbers = NUMBERS;
+	int intNumbers = INT_NUMBERS;
+
+	if (argc >= 2) numbers = atoi( argv[1]);
+	if (argc >= 3) intNumbers = atoi( argv[2]);
+	if (argc > 3 || numbers <= 0 || intNumbers <= 0)
+	{
+		fprintf( stderr, "usage: %s [STRINGS [INTS]]\n", argv[0]);
+		return 1;
+	}
+
+	// random strings of 4 ~ 15 letters
+	// most begin with "AAA", so many share a prefix and need compare to break ties
+	char **strs = (char **)malloc( sizeof(char *) * numbers);
+	char buf[16];
+	srand( 2);
+	for (int i = 0; i < numbers; i++)
+	{
+		int len = 4 + rand() % 12;
+		for (int j = 0; j < len; j++) buf[j] = (j < 3 && rand() % 4) ? 'A' : 'a' + rand() % 26;
+		buf[len] = 0;
+		strs[i] = strdup( buf);
+	}
+
+	// compare only (heap_CreateEx) and inline key prefixes (heap_CreateKey)
+	for (int keyed = 0; keyed < 2; keyed++)
+	{
+		for (int arity = 2; arity <= 8; arity *= 2)
+		{
+			HEAP *heap = keyed ? heap_CreateKey( 10, compare, keyStr, arity) : heap_CreateEx( 10, compare, arity);
+			double rate = bench( heap, strs, numbers);
+			if (rate == 0)
+			{
+				fprintf( stderr, "pops out of order\n");
+				return 1;
+			}
+			fprintf( stdout, "%s, arity %d: %d strings, %.2f M pops/s\n",
+				keyed ? "key prefix" : "compare only", arity, numbers, rate / 1e6);
+		}
+	}
+
+	for (int i = 0; i < numbers; i++) free( strs[i]);
+	free( strs);
+
+	// insert all + delete all of random ints with duplicates (compare only)
+	int *data = (int *)malloc( sizeof(int) * intNumbers);
+	for (int i = 0; i < intNumbers; i++) data[i] = rand() % (intNumbers / 2 + 1);
+
+	for (int arity = 2; arity <= 8; arity *= 2)
+	{
+		double total_time = bench_int( heap_CreateEx( 10, compare_int, arity), data, intNumbers);
+		if (total_time == 0)
+		{
+			fprintf( stderr, "deletes out of order\n");
+			return 1;
+		}
+		fprintf( stdout, "ints, arity %d: %d ints, insert all + delete all %.2f s\n", arity, intNumbers, total_time);
+	}
+	free( data);
+
+	return 0;
+}
@@ -15,6 +15,9 @@ int compare(void *arg1, void *arg2)
 	return *a1 - *a2;
 }
 
+/* key of an int (the whole priority) */
+HEAP_INT_KEY( keyInt, int)
+
 /* user-defined print function */
 void print_func(void *data)
 {
@@ -28,7 +31,7 @@ int main(void)
 	int *dataPtr;
 	int i;
 	
-	heap = heap_Create( 10, compare);
+	heap = heap_CreateKey( 10, compare, keyInt, 2);
 	
 	srand( time(NULL));
 	
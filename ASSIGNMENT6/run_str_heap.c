@@ -1,5 +1,5 @@
 #include <stdio.h>
-#include <string.h> // strdup
+#include <string.h> // strdup, strcmp
 #include <stdlib.h>
 #include "adt_heap.h"
 
@@ -9,6 +9,9 @@ int compare(void *arg1, void *arg2)
 	return strcmp((char *)arg1, (char *)arg2);
 }
 
+/* key prefix of a string (first 8 bytes) */
+HEAP_STR_KEY( keyStr)
+
 /* user-defined print function */
 void print_func(void *data)
 {
@@ -23,10 +26,20 @@ int main( int argc, char **argv)
 	char *dataPtr;
 	
 	char data[1024];
+	int arity = 2;
+	
+	// d-ary heap
+	if (argc == 4 && strcmp( argv[1], "-d") == 0)
+	{
+		arity = atoi( argv[2]);
+		argv[2] = argv[0];
+		argv += 2;
+		argc -= 2;
+	}
 	
 	if (argc != 2)
 	{
-		fprintf( stderr, "usage: %s FILE\n", argv[0]);
+		fprintf( stderr, "usage: %s [-d ARITY] FILE\n", argv[0]);
 		return 1;
 	}
 	
@@ -38,7 +51,13 @@ int main( int argc, char **argv)
 		return 1;
 	}
 	
-	heap = heap_Create( 10, compare); // initial capacity = 10
+	heap = heap_CreateKey( 10, compare, keyStr, arity); // initial capacity = 10
+	if (!heap)
+	{
+		fprintf( stderr, "cannot create a heap (arity 2, 4 or 8)\n");
+		fclose( fp);
+		return 1;
+	}
 	
 	while (fscanf( fp, "%s", data) != EOF)
 	{